@@ -0,0 +1,249 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <string>
+
+/**
+ * 候補実装の呼び出し中のメモリ確保を数える
+ * テストの実行ファイルのどれか1つの翻訳単位で ALGOTEST_ALLOC_HOOKS() を書くと
+ * グローバルな operator new / delete が置き換わる
+ * 書かなければ installed() が false で, 確保を見るテストは何もしない
+ *
+ * 各ブロックの前に大きさを書いておき, 解放時に生きているバイト数を減らす
+ * C++17 以降の整列指定付きの new (alignas(64) の型など) も数える
+ */
+namespace algotest {
+
+namespace alloc {
+
+struct Stats {
+    /// 確保の回数
+    size_t count = 0;
+    /// 確保したバイト数の合計
+    size_t bytes = 0;
+    /// 生きているバイト数の最大 (計測開始時からの増分)
+    size_t peak = 0;
+};
+
+struct State {
+    std::atomic<bool> installed{false};
+    std::atomic<size_t> count{0}, bytes{0}, live{0}, peak{0};
+};
+
+inline State& state() {
+    static State s;
+    return s;
+}
+
+/// ALGOTEST_ALLOC_HOOKS() があるか
+inline bool installed() {
+    return state().installed.load(std::memory_order_relaxed);
+}
+
+inline bool install() {
+    state().installed = true;
+    return true;
+}
+
+/// 大きさを書くヘッダ, operator new の返すアドレスの整列を保つ
+constexpr size_t kHeader = alignof(std::max_align_t);
+
+/// size バイトの確保を数える
+inline void count_allocate(size_t size) {
+    State& s = state();
+    s.count.fetch_add(1, std::memory_order_relaxed);
+    s.bytes.fetch_add(size, std::memory_order_relaxed);
+    size_t live = s.live.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = s.peak.load(std::memory_order_relaxed);
+    while (peak < live &&
+           !s.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;
+}
+
+inline void* allocate(size_t size) {
+    void* p = std::malloc(size + kHeader);
+    if (!p)
+        return nullptr;
+    *static_cast<size_t*>(p) = size;
+    count_allocate(size);
+    return static_cast<char*>(p) + kHeader;
+}
+
+// インライン展開されると, new で得たポインタを free していると警告される
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+inline void deallocate(void* p) {
+    if (!p)
+        return;
+    char* q = static_cast<char*>(p) - kHeader;
+    state().live.fetch_sub(*reinterpret_cast<size_t*>(q),
+                           std::memory_order_relaxed);
+    std::free(q);
+}
+
+/**
+ * align (2 冪) に揃えた確保, 返すアドレスの直前に大きさと malloc の返した
+ * アドレスを書く
+ */
+inline void* allocate_aligned(size_t size, size_t align) {
+    if (align < kHeader)
+        align = kHeader;
+    // 2 * sizeof(size_t) <= kHeader <= align なので前に2つ書ける
+    char* raw = static_cast<char*>(std::malloc(size + 2 * align));
+    if (!raw)
+        return nullptr;
+    uintptr_t user = (reinterpret_cast<uintptr_t>(raw) + 2 * sizeof(size_t) +
+                      align - 1) &
+                     ~uintptr_t(align - 1);
+    size_t* h = reinterpret_cast<size_t*>(user) - 2;
+    h[0] = size;
+    memcpy(h + 1, &raw, sizeof(raw));
+    count_allocate(size);
+    return reinterpret_cast<void*>(user);
+}
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+inline void deallocate_aligned(void* p) {
+    if (!p)
+        return;
+    size_t* h = static_cast<size_t*>(p) - 2;
+    char* raw;
+    memcpy(&raw, h + 1, sizeof(raw));
+    state().live.fetch_sub(h[0], std::memory_order_relaxed);
+    std::free(raw);
+}
+
+/// 生存期間中の確保を数える, 入れ子にはできない
+class Scope {
+  public:
+    Scope() {
+        State& s = state();
+        count0 = s.count;
+        bytes0 = s.bytes;
+        live0 = s.live;
+        s.peak = live0;
+    }
+
+    Stats stats() const {
+        State& s = state();
+        Stats st;
+        st.count = s.count - count0;
+        st.bytes = s.bytes - bytes0;
+        size_t peak = s.peak;
+        st.peak = peak > live0 ? peak - live0 : 0;
+        return st;
+    }
+
+  private:
+    size_t count0, bytes0, live0;
+};
+
+/// f() の中での確保
+template <class F>
+Stats measure(F f) {
+    Scope scope;
+    f();
+    return scope.stats();
+}
+
+inline std::string dump(const Stats& st) {
+    std::ostringstream os;
+    os << "count = " << st.count << ", bytes = " << st.bytes
+       << ", peak = " << st.peak;
+    return os.str();
+}
+
+}  // namespace alloc
+
+}  // namespace algotest
+
+#ifdef __cpp_aligned_new
+/// 整列指定付きの operator new / delete (C++17 以降)
+#define ALGOTEST_ALLOC_ALIGNED_HOOKS_                                        \
+    void* operator new(std::size_t size, std::align_val_t al) {              \
+        void* p = ::algotest::alloc::allocate_aligned(size, size_t(al));     \
+        if (!p)                                                              \
+            throw std::bad_alloc();                                          \
+        return p;                                                            \
+    }                                                                        \
+    void* operator new[](std::size_t size, std::align_val_t al) {            \
+        return operator new(size, al);                                       \
+    }                                                                        \
+    void* operator new(std::size_t size, std::align_val_t al,                \
+                       const std::nothrow_t&) noexcept {                     \
+        return ::algotest::alloc::allocate_aligned(size, size_t(al));        \
+    }                                                                        \
+    void* operator new[](std::size_t size, std::align_val_t al,              \
+                         const std::nothrow_t&) noexcept {                   \
+        return ::algotest::alloc::allocate_aligned(size, size_t(al));        \
+    }                                                                        \
+    void operator delete(void* p, std::align_val_t) noexcept {               \
+        ::algotest::alloc::deallocate_aligned(p);                            \
+    }                                                                        \
+    void operator delete[](void* p, std::align_val_t) noexcept {             \
+        ::algotest::alloc::deallocate_aligned(p);                            \
+    }                                                                        \
+    void operator delete(void* p, std::size_t, std::align_val_t) noexcept {  \
+        ::algotest::alloc::deallocate_aligned(p);                            \
+    }                                                                        \
+    void operator delete[](void* p, std::size_t,                             \
+                           std::align_val_t) noexcept {                      \
+        ::algotest::alloc::deallocate_aligned(p);                            \
+    }                                                                        \
+    void operator delete(void* p, std::align_val_t,                          \
+                         const std::nothrow_t&) noexcept {                   \
+        ::algotest::alloc::deallocate_aligned(p);                            \
+    }                                                                        \
+    void operator delete[](void* p, std::align_val_t,                        \
+                           const std::nothrow_t&) noexcept {                 \
+        ::algotest::alloc::deallocate_aligned(p);                            \
+    }
+#else
+#define ALGOTEST_ALLOC_ALIGNED_HOOKS_
+#endif
+
+/// グローバルな operator new / delete を置き換える, 1つの翻訳単位で1回だけ書く
+#define ALGOTEST_ALLOC_HOOKS()                                               \
+    void* operator new(std::size_t size) {                                   \
+        void* p = ::algotest::alloc::allocate(size);                         \
+        if (!p)                                                              \
+            throw std::bad_alloc();                                          \
+        return p;                                                            \
+    }                                                                        \
+    void* operator new[](std::size_t size) { return operator new(size); }    \
+    void* operator new(std::size_t size, const std::nothrow_t&) noexcept {   \
+        return ::algotest::alloc::allocate(size);                            \
+    }                                                                        \
+    void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { \
+        return ::algotest::alloc::allocate(size);                            \
+    }                                                                        \
+    void operator delete(void* p) noexcept {                                 \
+        ::algotest::alloc::deallocate(p);                                    \
+    }                                                                        \
+    void operator delete[](void* p) noexcept {                               \
+        ::algotest::alloc::deallocate(p);                                    \
+    }                                                                        \
+    void operator delete(void* p, std::size_t) noexcept {                    \
+        ::algotest::alloc::deallocate(p);                                    \
+    }                                                                        \
+    void operator delete[](void* p, std::size_t) noexcept {                  \
+        ::algotest::alloc::deallocate(p);                                    \
+    }                                                                        \
+    void operator delete(void* p, const std::nothrow_t&) noexcept {          \
+        ::algotest::alloc::deallocate(p);                                    \
+    }                                                                        \
+    void operator delete[](void* p, const std::nothrow_t&) noexcept {        \
+        ::algotest::alloc::deallocate(p);                                    \
+    }                                                                        \
+    ALGOTEST_ALLOC_ALIGNED_HOOKS_                                            \
+    static const bool algotest_alloc_hooks_installed =                       \
+        ::algotest::alloc::install()
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../perf.h"
+#include "benchmark/benchmark.h"
+
+namespace algotest {
+
+namespace bench {
+
+using Benchmark = ::benchmark::internal::Benchmark;
+
+/// prefix/name という名前でベンチマークを登録する
+/// 入力サイズは state.range(0) で受け取る
+inline Benchmark* add(const std::string& prefix,
+                      const std::string& name,
+                      void (*fn)(::benchmark::State&)) {
+    return ::benchmark::RegisterBenchmark((prefix + "/" + name).c_str(), fn);
+}
+
+/// [lo, hi] を mul 倍刻みで回す (lo, hi は 2 冪を想定)
+inline Benchmark* sizes(Benchmark* b, long long lo, long long hi, int mul = 4) {
+    return b->RangeMultiplier(mul)->Range(lo, hi);
+}
+
+/**
+ * 生存期間中をハードウェアカウンタで測り, 1 iteration あたりの値を
+ * state.counters に入れる (取れないカウンタは出さない)
+ * for (auto _ : state) の直前に置く
+ */
+class PerfScope {
+  public:
+    explicit PerfScope(::benchmark::State& _state) : state(_state) {
+        probe.start();
+    }
+    ~PerfScope() {
+        perf::Result r = probe.stop();
+        r.each([&](const std::string& name, double v) {
+            state.counters[name] =
+                ::benchmark::Counter(v, ::benchmark::Counter::kAvgIterations);
+        });
+    }
+
+  private:
+    ::benchmark::State& state;
+    perf::Probe probe;
+};
+
+/// クエリ系ベンチマークで1回の setup あたりに投げるクエリ数
+constexpr int kQueryCount = 1 << 16;
+
+}  // namespace bench
+
+}  // namespace algotest
+
+/**
+ * INSTANTIATE_TYPED_TEST_CASE_P と同じ要領で使う
+ * 例: ALGOTEST_INSTANTIATE_BENCH(MyRMQ, StaticRMQBench, SparseTable);
+ * "MyRMQ/StaticRMQBench/RangeMin/1024" のような名前で登録される
+ */
+#define ALGOTEST_INSTANTIATE_BENCH(Prefix, Suite, Type)             \
+    static const bool algotest_bench_##Prefix##_##Suite##_registered = \
+        ::algotest::bench::Suite<Type>::register_all(#Prefix "/" #Suite)
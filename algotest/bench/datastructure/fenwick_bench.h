@@ -0,0 +1,268 @@
+#pragma once
+
+#include "../../datastructure/fenwick_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename FENWICK>
+struct FenwickBench {
+    static std::vector<long long> gen_array(int n) {
+        algotest::random::Random gen;
+        std::vector<long long> a(n);
+        for (int i = 0; i < n; i++) {
+            a[i] = gen.uniform(0, 1000000000);
+        }
+        return a;
+    }
+
+    static void Setup(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto a = gen_array(n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            FENWICK your_fenwick;
+            your_fenwick.setup(a);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static void Add(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        FENWICK your_fenwick;
+        your_fenwick.setup(gen_array(n));
+        std::vector<int> ks(kQueryCount);
+        for (auto& k : ks) {
+            k = gen.uniform(0, n - 1);
+        }
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            your_fenwick.add(ks[i++ & (kQueryCount - 1)], 1);
+        }
+        ::benchmark::ClobberMemory();
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void Sum(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        FENWICK your_fenwick;
+        your_fenwick.setup(gen_array(n));
+        std::vector<std::pair<int, int>> qs(kQueryCount);
+        for (auto& q : qs) {
+            int l = gen.uniform(0, n - 1);
+            int r = gen.uniform(0, n - 1);
+            if (l > r)
+                std::swap(l, r);
+            q = {l, r + 1};
+        }
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto q = qs[i++ & (kQueryCount - 1)];
+            ::benchmark::DoNotOptimize(your_fenwick.sum(q.first, q.second));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Setup", Setup), 1 << 10, 1 << 22);
+        sizes(add(prefix, "Add", Add), 1 << 10, 1 << 22);
+        sizes(add(prefix, "Sum", Sum), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// 1 iteration で kQueryCount 個の sum を1個ずつ / まとめて投げて比べる
+template <typename FENWICK>
+struct FenwickBatchBench {
+    struct Input {
+        FENWICK fenwick;
+        std::vector<int> l, r;
+        std::vector<long long> out;
+    };
+
+    static void prepare(Input& in, int n) {
+        algotest::random::Random gen;
+        in.fenwick.setup(FenwickBench<FENWICK>::gen_array(n));
+        in.l.resize(kQueryCount);
+        in.r.resize(kQueryCount);
+        in.out.resize(kQueryCount);
+        for (int i = 0; i < kQueryCount; i++) {
+            int l = gen.uniform(0, n);
+            int r = gen.uniform(0, n);
+            if (l > r)
+                std::swap(l, r);
+            in.l[i] = l;
+            in.r[i] = r;
+        }
+    }
+
+    static void Sum(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            for (int i = 0; i < kQueryCount; i++) {
+                in.out[i] = in.fenwick.sum(in.l[i], in.r[i]);
+            }
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static void SumBatch(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            in.fenwick.sum_batch(in.l, in.r, in.out);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Sum", Sum), 1 << 10, 1 << 22);
+        sizes(add(prefix, "SumBatch", SumBatch), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// 区間加算・区間和, n は 2^10 ~ 2^24 (10^7 を含む)
+template <typename FENWICK>
+struct FenwickRangeBench {
+    static void Setup(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto a = FenwickBench<FENWICK>::gen_array(n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            FENWICK your_fenwick;
+            your_fenwick.setup(a);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static std::vector<std::pair<int, int>> gen_ranges(int n) {
+        algotest::random::Random gen;
+        std::vector<std::pair<int, int>> qs(kQueryCount);
+        for (auto& q : qs) {
+            q = fenwick::gen_range(gen, n);
+        }
+        return qs;
+    }
+
+    static void Add(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto a = FenwickBench<FENWICK>::gen_array(n);
+        FENWICK your_fenwick;
+        your_fenwick.setup(a);
+        auto qs = gen_ranges(n);
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto q = qs[i++ & (kQueryCount - 1)];
+            your_fenwick.add(q.first, q.second, 1);
+        }
+        ::benchmark::ClobberMemory();
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void Sum(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto a = FenwickBench<FENWICK>::gen_array(n);
+        FENWICK your_fenwick;
+        your_fenwick.setup(a);
+        auto qs = gen_ranges(n);
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto q = qs[i++ & (kQueryCount - 1)];
+            ::benchmark::DoNotOptimize(your_fenwick.sum(q.first, q.second));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Setup", Setup), 1 << 10, 1 << 24);
+        sizes(add(prefix, "Add", Add), 1 << 10, 1 << 24);
+        sizes(add(prefix, "Sum", Sum), 1 << 10, 1 << 24);
+        return true;
+    }
+};
+
+/// 2次元, state.range(0) x state.range(0) の格子 (64 ~ 4096)
+template <typename FENWICK>
+struct Fenwick2DBench {
+    static void Setup(::benchmark::State& state) {
+        int s = int(state.range(0));
+        auto a = FenwickBench<FENWICK>::gen_array(s * s);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            FENWICK your_fenwick;
+            your_fenwick.setup(s, s, a);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * s * s);
+    }
+
+    static void Add(::benchmark::State& state) {
+        int s = int(state.range(0));
+        algotest::random::Random gen;
+        FENWICK your_fenwick;
+        your_fenwick.setup(s, s, FenwickBench<FENWICK>::gen_array(s * s));
+        std::vector<std::pair<int, int>> ps(kQueryCount);
+        for (auto& p : ps) {
+            p = {gen.uniform(0, s - 1), gen.uniform(0, s - 1)};
+        }
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto p = ps[i++ & (kQueryCount - 1)];
+            your_fenwick.add(p.first, p.second, 1);
+        }
+        ::benchmark::ClobberMemory();
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void Sum(::benchmark::State& state) {
+        int s = int(state.range(0));
+        algotest::random::Random gen;
+        FENWICK your_fenwick;
+        your_fenwick.setup(s, s, FenwickBench<FENWICK>::gen_array(s * s));
+        struct Rect {
+            int y1, x1, y2, x2;
+        };
+        std::vector<Rect> qs(kQueryCount);
+        for (auto& q : qs) {
+            auto ys = fenwick::gen_range(gen, s);
+            auto xs = fenwick::gen_range(gen, s);
+            q = {ys.first, xs.first, ys.second, xs.second};
+        }
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            const Rect& q = qs[i++ & (kQueryCount - 1)];
+            ::benchmark::DoNotOptimize(
+                your_fenwick.sum(q.y1, q.x1, q.y2, q.x2));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Setup", Setup), 64, 4096);
+        sizes(add(prefix, "Add", Add), 64, 4096);
+        sizes(add(prefix, "Sum", Sum), 64, 4096);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
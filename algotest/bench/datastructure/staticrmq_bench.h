@@ -0,0 +1,153 @@
+#pragma once
+
+#include "../../datastructure/staticrmq_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename RMQ>
+struct StaticRMQBench {
+    static std::vector<int> gen_array(int n) {
+        algotest::random::Random gen;
+        std::vector<int> a(n);
+        for (int i = 0; i < n; i++) {
+            a[i] = gen.uniform(0, 1000000000);
+        }
+        return a;
+    }
+
+    static void Setup(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto a = gen_array(n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            RMQ your_rmq;
+            your_rmq.setup(a);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static void RangeMin(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        RMQ your_rmq;
+        your_rmq.setup(gen_array(n));
+        std::vector<std::pair<int, int>> qs(kQueryCount);
+        for (auto& q : qs) {
+            int l = gen.uniform(0, n - 1);
+            int r = gen.uniform(0, n - 1);
+            if (l > r)
+                std::swap(l, r);
+            q = {l, r + 1};
+        }
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto q = qs[i++ & (kQueryCount - 1)];
+            ::benchmark::DoNotOptimize(your_rmq.range_min(q.first, q.second));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Setup のうち, 値渡しで数列をコピーする分
+    static void CopyInput(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto a = gen_array(n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            std::vector<int> copy = a;
+            ::benchmark::DoNotOptimize(copy.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Setup", Setup), 1 << 10, 1 << 22);
+        sizes(add(prefix, "RangeMin", RangeMin), 1 << 10, 1 << 22);
+        sizes(add(prefix, "CopyInput", CopyInput), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// 1 iteration で kQueryCount 個のクエリを1個ずつ / まとめて投げて比べる
+template <typename RMQ>
+struct StaticRMQBatchBench {
+    struct Input {
+        RMQ rmq;
+        std::vector<int> l, r, out;
+    };
+
+    static void prepare(Input& in, int n) {
+        algotest::random::Random gen;
+        in.rmq.setup(StaticRMQBench<RMQ>::gen_array(n));
+        in.l.resize(kQueryCount);
+        in.r.resize(kQueryCount);
+        in.out.resize(kQueryCount);
+        for (int i = 0; i < kQueryCount; i++) {
+            int l = gen.uniform(0, n - 1);
+            int r = gen.uniform(0, n - 1);
+            if (l > r)
+                std::swap(l, r);
+            in.l[i] = l;
+            in.r[i] = r + 1;
+        }
+    }
+
+    static void RangeMin(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            for (int i = 0; i < kQueryCount; i++) {
+                in.out[i] = in.rmq.range_min(in.l[i], in.r[i]);
+            }
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static void RangeMinBatch(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            in.rmq.range_min_batch(in.l, in.r, in.out);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "RangeMin", RangeMin), 1 << 10, 1 << 22);
+        sizes(add(prefix, "RangeMinBatch", RangeMinBatch), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// Span で渡す版の setup
+template <typename RMQ>
+struct StaticRMQViewBench {
+    static void Setup(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto a = StaticRMQBench<RMQ>::gen_array(n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            RMQ your_rmq;
+            your_rmq.setup(a);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Setup", Setup), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "../../datastructure/wavelet_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename WAVELET>
+struct WaveletBench {
+    static std::vector<int> gen_array(int n) {
+        algotest::random::Random gen;
+        std::vector<int> a(n);
+        for (int i = 0; i < n; i++) {
+            a[i] = gen.uniform(0, n - 1);
+        }
+        return a;
+    }
+
+    static std::vector<std::pair<int, int>> gen_ranges(int n) {
+        algotest::random::Random gen;
+        std::vector<std::pair<int, int>> qs(kQueryCount);
+        for (auto& q : qs) {
+            int l = gen.uniform(0, n - 1);
+            int r = gen.uniform(0, n - 1);
+            if (l > r)
+                std::swap(l, r);
+            q = {l, r + 1};
+        }
+        return qs;
+    }
+
+    static void Setup(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto a = gen_array(n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            WAVELET your_wavelet;
+            your_wavelet.setup(a);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static void Rank(::benchmark::State& state) {
+        int n = int(state.range(0));
+        WAVELET your_wavelet;
+        your_wavelet.setup(gen_array(n));
+        auto qs = gen_ranges(n);
+        algotest::random::Random gen;
+        std::vector<int> xs(kQueryCount);
+        for (auto& x : xs) {
+            x = gen.uniform(0, n);
+        }
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            size_t j = i++ & (kQueryCount - 1);
+            ::benchmark::DoNotOptimize(
+                your_wavelet.rank(qs[j].first, qs[j].second, xs[j]));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void Select(::benchmark::State& state) {
+        int n = int(state.range(0));
+        WAVELET your_wavelet;
+        your_wavelet.setup(gen_array(n));
+        auto qs = gen_ranges(n);
+        algotest::random::Random gen;
+        std::vector<int> ks(kQueryCount);
+        for (int j = 0; j < kQueryCount; j++) {
+            ks[j] = gen.uniform(0, qs[j].second - qs[j].first - 1);
+        }
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            size_t j = i++ & (kQueryCount - 1);
+            ::benchmark::DoNotOptimize(
+                your_wavelet.select(qs[j].first, qs[j].second, ks[j]));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Setup", Setup), 1 << 10, 1 << 22);
+        sizes(add(prefix, "Rank", Rank), 1 << 10, 1 << 22);
+        sizes(add(prefix, "Select", Select), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// 1 iteration で kQueryCount 個の rank / select を1個ずつ / まとめて投げて比べる
+template <typename WAVELET>
+struct WaveletBatchBench {
+    struct Input {
+        WAVELET wavelet;
+        std::vector<int> l, r, x, k, out;
+    };
+
+    static void prepare(Input& in, int n) {
+        algotest::random::Random gen;
+        in.wavelet.setup(WaveletBench<WAVELET>::gen_array(n));
+        auto qs = WaveletBench<WAVELET>::gen_ranges(n);
+        in.l.resize(kQueryCount);
+        in.r.resize(kQueryCount);
+        in.x.resize(kQueryCount);
+        in.k.resize(kQueryCount);
+        in.out.resize(kQueryCount);
+        for (int i = 0; i < kQueryCount; i++) {
+            in.l[i] = qs[i].first;
+            in.r[i] = qs[i].second;
+            in.x[i] = gen.uniform(0, n);
+            in.k[i] = gen.uniform(0, qs[i].second - qs[i].first - 1);
+        }
+    }
+
+    static void Rank(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            for (int i = 0; i < kQueryCount; i++) {
+                in.out[i] = in.wavelet.rank(in.l[i], in.r[i], in.x[i]);
+            }
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static void RankBatch(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            in.wavelet.rank_batch(in.l, in.r, in.x, in.out);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static void Select(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            for (int i = 0; i < kQueryCount; i++) {
+                in.out[i] = in.wavelet.select(in.l[i], in.r[i], in.k[i]);
+            }
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static void SelectBatch(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            in.wavelet.select_batch(in.l, in.r, in.k, in.out);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Rank", Rank), 1 << 10, 1 << 22);
+        sizes(add(prefix, "RankBatch", RankBatch), 1 << 10, 1 << 22);
+        sizes(add(prefix, "Select", Select), 1 << 10, 1 << 22);
+        sizes(add(prefix, "SelectBatch", SelectBatch), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../../graph/dijkstra_test.h"
+#include "../../graph/generator.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename DIJKSTRA>
+struct DijkstraBench {
+    /// 頂点数 m / 4, 辺数 m のランダムグラフ
+    static void MinDist(::benchmark::State& state) {
+        using G = std::vector<std::vector<DijkstraEdge>>;
+        int m = int(state.range(0));
+        int n = std::max(2, m / 4);
+        algotest::random::Random gen;
+        G g(n);
+        for (int i = 0; i < m; i++) {
+            int a = gen.uniform(0, n - 1);
+            int b = gen.uniform(0, n - 1);
+            g[a].push_back(DijkstraEdge{b, gen.uniform(0LL, 1000000000LL)});
+        }
+        PerfScope counters(state);
+        for (auto _ : state) {
+            DIJKSTRA your_dijkstra;
+            ::benchmark::DoNotOptimize(your_dijkstra.min_dist(g, 0, n - 1));
+        }
+        state.SetItemsProcessed(state.iterations() * m);
+    }
+
+    /// MinDist のうち, 値渡しでグラフをコピーする分
+    static void CopyInput(::benchmark::State& state) {
+        using G = std::vector<std::vector<DijkstraEdge>>;
+        int m = int(state.range(0));
+        int n = std::max(2, m / 4);
+        algotest::random::Random gen;
+        csr::CSR h = generator::random_graph(n, m, gen);
+        generator::assign_costs(h, 0, 1000000000, gen);
+        G g = csr::to_weighted_adjacency<DijkstraEdge>(h);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            G copy = g;
+            ::benchmark::DoNotOptimize(copy.data());
+        }
+        state.SetItemsProcessed(state.iterations() * m);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "MinDist", MinDist), 1 << 10, 1 << 22);
+        sizes(add(prefix, "CopyInput", CopyInput), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// CSRView で渡す版, 入力のコピーがないので DijkstraBench::MinDist との差が
+/// DijkstraBench::CopyInput に近くなるはず
+template <typename DIJKSTRA>
+struct DijkstraViewBench {
+    /// 頂点数 m / 4, 辺数 m のランダムグラフ
+    static void MinDist(::benchmark::State& state) {
+        int m = int(state.range(0));
+        int n = std::max(2, m / 4);
+        algotest::random::Random gen;
+        csr::CSR g = generator::random_graph(n, m, gen);
+        generator::assign_costs(g, 0, 1000000000, gen);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            DIJKSTRA your_dijkstra;
+            ::benchmark::DoNotOptimize(your_dijkstra.min_dist(g, 0, n - 1));
+        }
+        state.SetItemsProcessed(state.iterations() * m);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "MinDist", MinDist), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
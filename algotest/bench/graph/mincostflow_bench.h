@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../../graph/mincostflow_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename MCF>
+struct MinCostFlowBench {
+    /// 頂点数 n, 辺数 4n のランダムグラフ
+    static void MaxFlowMinCost(::benchmark::State& state) {
+        using G = std::vector<std::vector<MinCostFlowEdge>>;
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        G g(n);
+        for (int i = 0; i < 4 * n; i++) {
+            int x = gen.uniform(0, n - 1);
+            int y = gen.uniform(0, n - 1);
+            if (x == y)
+                continue;
+            g[x].push_back(MinCostFlowEdge{y, gen.uniform(0, 100),
+                                           gen.uniform(0LL, 100LL)});
+        }
+        PerfScope counters(state);
+        for (auto _ : state) {
+            MCF your_mcf;
+            ::benchmark::DoNotOptimize(
+                your_mcf.max_flow_min_cost(g, 0, n - 1));
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "MaxFlowMinCost", MaxFlowMinCost), 1 << 6, 1 << 12);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../../graph/scc_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename SCC>
+struct SCCBench {
+    /// 頂点数 m / 4, 辺数 m のランダム有向グラフ
+    static void TopologicalOrder(::benchmark::State& state) {
+        using G = std::vector<std::vector<SCCEdge>>;
+        int m = int(state.range(0));
+        int n = std::max(1, m / 4);
+        algotest::random::Random gen;
+        G g(n);
+        for (int i = 0; i < m; i++) {
+            int a = gen.uniform(0, n - 1);
+            int b = gen.uniform(0, n - 1);
+            g[a].push_back(SCCEdge{b});
+        }
+        PerfScope counters(state);
+        for (auto _ : state) {
+            SCC your_scc;
+            auto order = your_scc.topological_order(g);
+            ::benchmark::DoNotOptimize(order.data());
+        }
+        state.SetItemsProcessed(state.iterations() * m);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "TopologicalOrder", TopologicalOrder), 1 << 10,
+              1 << 22);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
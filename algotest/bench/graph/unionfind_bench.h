@@ -0,0 +1,98 @@
+#pragma once
+
+#include <thread>
+#include "../../graph/unionfind_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename UF>
+struct UnionFindBench {
+    /// 頂点数 n で add と is_connect を n 回ずつ交互に呼ぶ
+    static void Mixed(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        std::vector<std::pair<int, int>> qs(2 * n);
+        for (auto& q : qs) {
+            q = {gen.uniform(0, n - 1), gen.uniform(0, n - 1)};
+        }
+        PerfScope counters(state);
+        for (auto _ : state) {
+            UF your_uf;
+            your_uf.setup(n);
+            for (int i = 0; i < n; i++) {
+                your_uf.add(qs[2 * i].first, qs[2 * i].second);
+                ::benchmark::DoNotOptimize(
+                    your_uf.is_connect(qs[2 * i + 1].first,
+                                       qs[2 * i + 1].second));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * 2 * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Mixed", Mixed), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/**
+ * 頂点数 10^7 に 10^7 回の add を state.range(0) スレッドで分けて呼ぶ
+ * 1 iteration = setup + 全スレッドの add, 実時間で測る
+ */
+template <typename UF>
+struct ConcurrentUnionFindBench {
+    static constexpr int kN = 10000000;
+
+    static const std::vector<std::pair<int, int>>& unions() {
+        static const std::vector<std::pair<int, int>> es = [] {
+            algotest::random::Random gen;
+            std::vector<std::pair<int, int>> v(kN);
+            for (auto& e : v) {
+                e = {gen.uniform(0, kN - 1), gen.uniform(0, kN - 1)};
+            }
+            return v;
+        }();
+        return es;
+    }
+
+    static void Add(::benchmark::State& state) {
+        int threads = int(state.range(0));
+        const auto& es = unions();
+        PerfScope counters(state);
+        for (auto _ : state) {
+            UF your_uf;
+            your_uf.setup(kN);
+            std::vector<std::thread> ths;
+            for (int t = 0; t < threads; t++) {
+                ths.emplace_back([&, t] {
+                    size_t l = es.size() * t / threads;
+                    size_t r = es.size() * (t + 1) / threads;
+                    for (size_t i = l; i < r; i++) {
+                        your_uf.add(es[i].first, es[i].second);
+                    }
+                });
+            }
+            for (auto& th : ths) {
+                th.join();
+            }
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kN);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        add(prefix, "Add", Add)
+            ->RangeMultiplier(2)
+            ->Range(1, 64)
+            ->UseRealTime()
+            ->Unit(::benchmark::kMillisecond);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
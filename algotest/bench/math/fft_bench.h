@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../../math/fft_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename FFT>
+struct FFTBench {
+    /// 長さ n 同士の積 (0 <= a_i, b_i <= 100)
+    static void Multiply(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        std::vector<long long> a(n), b(n);
+        for (int i = 0; i < n; i++) {
+            a[i] = gen.uniform(0, 100);
+            b[i] = gen.uniform(0, 100);
+        }
+        PerfScope counters(state);
+        for (auto _ : state) {
+            FFT your_fft;
+            auto out = your_fft.multiply(a, b);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Multiply", Multiply), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// 係数を分割する版
+template <typename FFT>
+struct FFTSplitBench {
+    /// 長さ n 同士の積 (0 <= a_i, b_i <= 10^9)
+    static void Multiply(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        auto a = gen.uniform_vector(n, 0LL, 1000000000LL);
+        auto b = gen.uniform_vector(n, 0LL, 1000000000LL);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            FFT your_fft;
+            auto out = your_fft.multiply(a, b);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Multiply", Multiply), 1 << 10, 1 << 21);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "../../math/gcd_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename GCD>
+struct GCDBench {
+    /// state.range(0) ビット以下の (x, y) を kQueryCount 組
+    static std::vector<std::pair<long long, long long>> gen_pairs(int bits) {
+        algotest::random::Random gen;
+        long long hi = (bits >= 63) ? 1000000000000000000LL : (1LL << bits) - 1;
+        std::vector<std::pair<long long, long long>> ps(kQueryCount);
+        for (auto& p : ps) {
+            p = {gen.uniform(-hi, hi), gen.uniform(-hi, hi)};
+        }
+        return ps;
+    }
+
+    static void Gcd(::benchmark::State& state) {
+        auto ps = gen_pairs(int(state.range(0)));
+        GCD your_gcd;
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto p = ps[i++ & (kQueryCount - 1)];
+            ::benchmark::DoNotOptimize(your_gcd.gcd(p.first, p.second));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void ExtGcd(::benchmark::State& state) {
+        auto ps = gen_pairs(int(state.range(0)));
+        GCD your_gcd;
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto p = ps[i++ & (kQueryCount - 1)];
+            ::benchmark::DoNotOptimize(your_gcd.ext_gcd(p.first, p.second));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static bool register_all(const std::string& prefix) {
+        add(prefix, "Gcd", Gcd)->Arg(16)->Arg(32)->Arg(63);
+        add(prefix, "ExtGcd", ExtGcd)->Arg(16)->Arg(32)->Arg(63);
+        return true;
+    }
+};
+
+/**
+ * 2^20 組を1個ずつ / まとめて投げる, 1 iteration で全て処理する
+ * state.range(0) ビット以下の一様な値, 0 なら隣り合う Fibonacci 数 (最悪ケース)
+ */
+template <typename GCD>
+struct GCDBatchBench {
+    static constexpr int kCount = 1 << 20;
+
+    struct Input {
+        std::vector<long long> x, y;
+    };
+
+    static Input gen_input(::benchmark::State& state) {
+        int bits = int(state.range(0));
+        algotest::random::Random gen;
+        Input in;
+        in.x.resize(kCount);
+        in.y.resize(kCount);
+        if (bits == 0) {
+            std::vector<long long> fib = {1, 2};
+            while (fib.back() <= 1000000000000000000LL - fib[fib.size() - 2])
+                fib.push_back(fib.back() + fib[fib.size() - 2]);
+            for (int i = 0; i < kCount; i++) {
+                size_t k = gen.uniform(size_t(0), fib.size() - 2);
+                in.x[i] = fib[k + 1] * (gen.uniform_bool() ? 1 : -1);
+                in.y[i] = fib[k];
+            }
+            state.SetLabel("fibonacci");
+        } else {
+            long long hi = (1LL << bits) - 1;
+            for (int i = 0; i < kCount; i++) {
+                in.x[i] = gen.uniform(-hi, hi);
+                in.y[i] = gen.uniform(-hi, hi);
+            }
+        }
+        return in;
+    }
+
+    static void Gcd(::benchmark::State& state) {
+        Input in = gen_input(state);
+        std::vector<uint64_t> out(kCount);
+        GCD your_gcd;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            for (int i = 0; i < kCount; i++) {
+                out[i] = uint64_t(your_gcd.gcd(in.x[i], in.y[i]));
+            }
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kCount);
+    }
+
+    static void GcdBatch(::benchmark::State& state) {
+        Input in = gen_input(state);
+        std::vector<uint64_t> out(kCount);
+        GCD your_gcd;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            your_gcd.gcd_batch(in.x, in.y, out);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kCount);
+    }
+
+    static void ExtGcd(::benchmark::State& state) {
+        Input in = gen_input(state);
+        std::vector<long long> a(kCount), b(kCount);
+        GCD your_gcd;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            for (int i = 0; i < kCount; i++) {
+                auto p = your_gcd.ext_gcd(in.x[i], in.y[i]);
+                a[i] = p.first;
+                b[i] = p.second;
+            }
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kCount);
+    }
+
+    static void ExtGcdBatch(::benchmark::State& state) {
+        Input in = gen_input(state);
+        std::vector<long long> a(kCount), b(kCount);
+        GCD your_gcd;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            your_gcd.ext_gcd_batch(in.x, in.y, a, b);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kCount);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        // 単発の gcd, ext_gcd の制約 (|x|, |y| <= 1e18) に収まる入力だけ使う
+        for (auto fn : {std::make_pair("Gcd", Gcd),
+                        std::make_pair("GcdBatch", GcdBatch),
+                        std::make_pair("ExtGcd", ExtGcd),
+                        std::make_pair("ExtGcdBatch", ExtGcdBatch)}) {
+            add(prefix, fn.first, fn.second)->Arg(0)->Arg(16)->Arg(32)->Arg(59);
+        }
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
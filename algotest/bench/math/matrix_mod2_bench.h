@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../../math/matrix_mod2_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename MATRIX>
+struct MatrixMod2Bench {
+    /// n x n でランク n / 2 の行列
+    static void Rank(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        auto mat = matrixmod2::uniform_mat(n, n, n / 2, gen);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            MATRIX your_mat;
+            ::benchmark::DoNotOptimize(your_mat.rank(mat));
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static void LinearEquation(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        auto mat = matrixmod2::uniform_mat(n, n, n, gen);
+        std::vector<int> vec(n);
+        for (auto& x : vec) {
+            x = gen.uniform_bool();
+        }
+        PerfScope counters(state);
+        for (auto _ : state) {
+            MATRIX your_mat;
+            auto out = your_mat.linear_equation(mat, vec);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Rank", Rank), 1 << 6, 1 << 10, 2);
+        sizes(add(prefix, "LinearEquation", LinearEquation), 1 << 6, 1 << 10,
+              2);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../../math/matrix_mod_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+/// n x n でランク k の行列
+inline matrixmod::Mat matrix_mod_bench_mat(int n, int k) {
+    algotest::random::Random gen;
+    return matrixmod::uniform_mat(n, n, k, gen);
+}
+
+template <typename MATRIX>
+struct MatrixModRankBench {
+    static void Rank(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto mat = matrix_mod_bench_mat(n, n / 2);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            MATRIX your_mat;
+            ::benchmark::DoNotOptimize(your_mat.rank(mat));
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Rank", Rank), 1 << 6, 1 << 9, 2);
+        return true;
+    }
+};
+
+template <typename MATRIX>
+struct MatrixModDetBench {
+    static void Det(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto mat = matrix_mod_bench_mat(n, n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            MATRIX your_mat;
+            ::benchmark::DoNotOptimize(your_mat.det(mat));
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Det", Det), 1 << 6, 1 << 9, 2);
+        return true;
+    }
+};
+
+template <typename MATRIX>
+struct MatrixModLinearEquationBench {
+    static void LinearEquation(::benchmark::State& state) {
+        constexpr long long kMod = MatrixModTesterBase::kMod;
+        int n = int(state.range(0));
+        auto mat = matrix_mod_bench_mat(n, n);
+        algotest::random::Random gen;
+        std::vector<long long> vec(n);
+        for (auto& x : vec) {
+            x = gen.uniform(0LL, kMod - 1);
+        }
+        PerfScope counters(state);
+        for (auto _ : state) {
+            MATRIX your_mat;
+            auto out = your_mat.linear_equation(mat, vec);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "LinearEquation", LinearEquation), 1 << 6, 1 << 9,
+              2);
+        return true;
+    }
+};
+
+template <typename MATRIX>
+struct MatrixModInverseBench {
+    static void Inverse(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto mat = matrix_mod_bench_mat(n, n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            MATRIX your_mat;
+            auto out = your_mat.inverse(mat);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Inverse", Inverse), 1 << 6, 1 << 9, 2);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
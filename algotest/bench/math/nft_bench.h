@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../../math/nft_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename NFT>
+struct NFTBench {
+    /// 長さ n 同士の積
+    static void Multiply(::benchmark::State& state) {
+        constexpr long long kMod = NFTTesterBase::kMod;
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        std::vector<long long> a(n), b(n);
+        for (int i = 0; i < n; i++) {
+            a[i] = gen.uniform(0LL, kMod - 1);
+            b[i] = gen.uniform(0LL, kMod - 1);
+        }
+        PerfScope counters(state);
+        for (auto _ : state) {
+            NFT your_nft;
+            auto out = your_nft.multiply(a, b);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    /// Multiply のうち, 値渡しで a, b をコピーする分
+    static void CopyInput(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        auto a = gen.uniform_vector(n, 0LL, NFTTesterBase::kMod - 1);
+        auto b = gen.uniform_vector(n, 0LL, NFTTesterBase::kMod - 1);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            std::vector<long long> ca = a, cb = b;
+            ::benchmark::DoNotOptimize(ca.data());
+            ::benchmark::DoNotOptimize(cb.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Multiply", Multiply), 1 << 10, 1 << 22);
+        sizes(add(prefix, "CopyInput", CopyInput), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// Span で渡す版
+template <typename NFT>
+struct NFTViewBench {
+    /// 長さ n 同士の積
+    static void Multiply(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        auto a = gen.uniform_vector(n, 0LL, NFTViewTesterBase::kMod - 1);
+        auto b = gen.uniform_vector(n, 0LL, NFTViewTesterBase::kMod - 1);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            NFT your_nft;
+            auto out = your_nft.multiply(a, b);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Multiply", Multiply), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// 任意の法の版
+template <typename NFT>
+struct NFTArbitraryModBench {
+    /// 長さ n 同士の積, 法は 10^9 + 7 (kind = 0) か 2^61 - 1 (kind = 1)
+    static void Multiply(::benchmark::State& state) {
+        const long long mod =
+            state.range(0) == 0 ? 1000000007 : (1LL << 61) - 1;
+        int n = int(state.range(1));
+        algotest::random::Random gen;
+        auto a = gen.uniform_vector(n, 0LL, mod - 1);
+        auto b = gen.uniform_vector(n, 0LL, mod - 1);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            NFT your_nft;
+            auto out = your_nft.multiply(a, b, mod);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        for (int kind = 0; kind < 2; kind++) {
+            for (long long n = 1 << 10; n <= 1 << 22; n *= 4)
+                add(prefix, "Multiply", Multiply)->Args({kind, n});
+        }
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
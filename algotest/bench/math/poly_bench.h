@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../../math/poly_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename POLY>
+struct PolyBench {
+    static std::vector<long long> gen_poly(int n, algotest::random::Random& gen) {
+        constexpr long long kMod = PolyTesterBase::kMod;
+        std::vector<long long> a(n);
+        for (int i = 0; i < n; i++) {
+            a[i] = gen.uniform(1LL, kMod - 1);
+        }
+        return a;
+    }
+
+    static void Mul(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        auto a = gen_poly(n, gen), b = gen_poly(n, gen);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            POLY your_poly;
+            auto out = your_poly.mul(a, b);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    /// 長さ 2n を長さ n で割る
+    static void Div(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        auto a = gen_poly(2 * n, gen), b = gen_poly(n, gen);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            POLY your_poly;
+            auto out = your_poly.div(a, b);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static void Inv(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        auto a = gen_poly(n, gen);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            POLY your_poly;
+            auto out = your_poly.inv(a, size_t(n));
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static void Sqrt(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        auto a = gen_poly(n, gen);
+        a[0] = 1;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            POLY your_poly;
+            auto out = your_poly.sqrt(a, size_t(n));
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Mul", Mul), 1 << 10, 1 << 20);
+        sizes(add(prefix, "Div", Div), 1 << 10, 1 << 20);
+        sizes(add(prefix, "Inv", Inv), 1 << 10, 1 << 20);
+        sizes(add(prefix, "Sqrt", Sqrt), 1 << 10, 1 << 20);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
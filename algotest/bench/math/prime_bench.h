@@ -0,0 +1,196 @@
+#pragma once
+
+#include "../../alloc.h"
+#include "../../math/prime_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename Prime>
+struct PrimeBench {
+    /// state.range(0) ビット以下のランダムな値
+    static std::vector<long long> gen_values(int bits, int n) {
+        algotest::random::Random gen;
+        long long hi =
+            (bits >= 61) ? 2000000000000000000LL : (1LL << bits) - 1;
+        std::vector<long long> xs(n);
+        for (auto& x : xs) {
+            x = gen.uniform(1LL, hi);
+        }
+        return xs;
+    }
+
+    static void IsPrime(::benchmark::State& state) {
+        auto xs = gen_values(int(state.range(0)), kQueryCount);
+        Prime your_prime;
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            ::benchmark::DoNotOptimize(
+                your_prime.is_prime(xs[i++ & (kQueryCount - 1)]));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void Factor(::benchmark::State& state) {
+        constexpr int kCount = 1 << 10;
+        auto xs = gen_values(int(state.range(0)), kCount);
+        Prime your_prime;
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto fs = your_prime.factor(xs[i++ & (kCount - 1)]);
+            ::benchmark::DoNotOptimize(fs.data());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static bool register_all(const std::string& prefix) {
+        add(prefix, "IsPrime", IsPrime)->Arg(20)->Arg(40)->Arg(61);
+        add(prefix, "Factor", Factor)->Arg(20)->Arg(40)->Arg(61);
+        return true;
+    }
+};
+
+/**
+ * state.range(0) 種類 (prime::Kind) の値 state.range(1) 個を1個ずつ / まとめて投げる
+ * 1 iteration で全ての値を処理する
+ */
+template <typename Prime>
+struct PrimeBatchBench {
+    static std::vector<uint64_t> values(::benchmark::State& state) {
+        algotest::random::Random gen;
+        int kind = int(state.range(0));
+        state.SetLabel(prime::kind_name(kind));
+        return prime::gen_values(gen, kind, int(state.range(1)));
+    }
+
+    static void IsPrime(::benchmark::State& state) {
+        auto xs = values(state);
+        std::vector<uint8_t> out(xs.size());
+        Prime your_prime;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            for (size_t i = 0; i < xs.size(); i++) {
+                out[i] = your_prime.is_prime((long long)(xs[i]));
+            }
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * xs.size());
+    }
+
+    static void IsPrimeBatch(::benchmark::State& state) {
+        auto xs = values(state);
+        std::vector<uint8_t> out(xs.size());
+        Prime your_prime;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            your_prime.is_prime_batch(xs, out);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * xs.size());
+    }
+
+    static void Factor(::benchmark::State& state) {
+        auto xs = values(state);
+        Prime your_prime;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            for (uint64_t x : xs) {
+                auto fs = your_prime.factor((long long)(x));
+                ::benchmark::DoNotOptimize(fs.data());
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * xs.size());
+    }
+
+    static void FactorBatch(::benchmark::State& state) {
+        auto xs = values(state);
+        std::vector<uint64_t> factors;
+        std::vector<int> start(xs.size() + 1);
+        Prime your_prime;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            factors.clear();
+            your_prime.factor_batch(xs, factors, start);
+            ::benchmark::DoNotOptimize(factors.data());
+        }
+        state.SetItemsProcessed(state.iterations() * xs.size());
+    }
+
+    static bool register_all(const std::string& prefix) {
+        // 素数判定は 10^6 ~ 10^7 個, 素因数分解は重い (semiprime で数百 us) ので
+        // 10^4 ~ 10^5 個
+        for (int kind = 0; kind < prime::kKindCount; kind++) {
+            for (int n : {1000000, 10000000}) {
+                add(prefix, "IsPrime", IsPrime)->Args({kind, n});
+                add(prefix, "IsPrimeBatch", IsPrimeBatch)->Args({kind, n});
+            }
+            for (int n : {10000, 100000}) {
+                add(prefix, "Factor", Factor)
+                    ->Args({kind, n})
+                    ->Unit(::benchmark::kMillisecond);
+                add(prefix, "FactorBatch", FactorBatch)
+                    ->Args({kind, n})
+                    ->Unit(::benchmark::kMillisecond);
+            }
+        }
+        return true;
+    }
+};
+
+template <typename Prime>
+struct PrimeSieveBench {
+    /**
+     * 10^12 で終わる長さ state.range(0) の区間の列挙, items_per_second は見つけた素数の数
+     * ALGOTEST_ALLOC_HOOKS() があれば1回の呼び出しのピークメモリ (peak_bytes) も出す
+     */
+    static void Primes(::benchmark::State& state) {
+        const long long r = 1000000000000LL, l = r - state.range(0);
+        Prime your_prime;
+        if (alloc::installed()) {
+            alloc::Stats st = alloc::measure([&] {
+                auto ps = your_prime.primes(l, r);
+                ::benchmark::DoNotOptimize(ps.data());
+            });
+            state.counters["peak_bytes"] = double(st.peak);
+        }
+        long long found = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto ps = your_prime.primes(l, r);
+            found += (long long)(ps.size());
+            ::benchmark::DoNotOptimize(ps.data());
+        }
+        state.SetItemsProcessed(found);
+    }
+
+    /// π(10^state.range(0))
+    static void PrimePi(::benchmark::State& state) {
+        long long n = 1;
+        for (int i = 0; i < state.range(0); i++)
+            n *= 10;
+        Prime your_prime;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            ::benchmark::DoNotOptimize(your_prime.prime_pi(n));
+        }
+    }
+
+    static bool register_all(const std::string& prefix) {
+        // 区間の長さは 10^9 まで (PrimeSieveTesterBase の約束)
+        sizes(add(prefix, "Primes", Primes), 1 << 16, 1 << 28)
+            ->Arg(1000000000)
+            ->Unit(::benchmark::kMillisecond);
+        add(prefix, "PrimePi", PrimePi)
+            ->DenseRange(8, 12)
+            ->Unit(::benchmark::kMillisecond);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
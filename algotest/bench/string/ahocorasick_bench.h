@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include "../../footprint.h"
+#include "../../string/ahocorasick_test.h"
+#include "../bench.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define ALGOTEST_BENCH_MMAP 1
+#endif
+
+namespace algotest {
+
+namespace bench {
+
+template <typename AC>
+struct AhoCorasickBench {
+    /// 長さ n のランダム文字列に対し, 長さ 4 ~ 8 のパターン 100 個
+    static void Enumerate(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        std::string target = gen.lower_string(n);
+        std::vector<std::string> patterns(100);
+        for (auto& p : patterns) {
+            int len = gen.uniform(4, 8);
+            int st = gen.uniform(0, std::max(0, n - len));
+            p = target.substr(st, len);
+        }
+        PerfScope counters(state);
+        for (auto _ : state) {
+            AC your_ahocorasick;
+            auto out = your_ahocorasick.enumerate(target, patterns);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetBytesProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Enumerate", Enumerate), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/**
+ * 一時ファイルに書いた文字列を mmap して読む (mmap がなければメモリ上に置く)
+ * ページキャッシュに載った状態のファイルを読む速さになる
+ */
+class MappedText {
+  public:
+    explicit MappedText(const std::string& text) : len(text.size()) {
+#ifdef ALGOTEST_BENCH_MMAP
+        FILE* fp = std::tmpfile();
+        if (fp && std::fwrite(text.data(), 1, len, fp) == len &&
+            std::fflush(fp) == 0) {
+            void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+            if (p != MAP_FAILED) {
+                size_t size = len;
+                owner = std::shared_ptr<void>(
+                    p, [size](void* q) { munmap(q, size); });
+                base = static_cast<const char*>(p);
+            }
+        }
+        if (fp)
+            std::fclose(fp);
+#endif
+        if (!base) {
+            auto buf = std::make_shared<std::string>(text);
+            base = buf->data();
+            owner = buf;
+        }
+    }
+
+    const char* data() const { return base; }
+    size_t size() const { return len; }
+
+  private:
+    size_t len;
+    const char* base = nullptr;
+    std::shared_ptr<void> owner;
+};
+
+template <typename AC>
+struct AhoCorasickStreamBench {
+    /// 長さ n のランダム文字列と, その部分文字列 (長さ 4 ~ 12) 1000 個
+    static std::vector<std::string> prepare(int n, std::string& text) {
+        algotest::random::Random gen;
+        text = gen.lower_string(n);
+        std::vector<std::string> patterns(1000);
+        for (auto& p : patterns) {
+            int len = gen.uniform(4, 12);
+            int st = gen.uniform(0, std::max(0, n - len));
+            p = text.substr(st, len);
+        }
+        return patterns;
+    }
+
+    static void run(::benchmark::State& state,
+                    int n,
+                    size_t chunk_size) {
+        std::string text;
+        auto patterns = prepare(n, text);
+        MappedText file(text);
+        AC your_ahocorasick;
+        your_ahocorasick.setup(patterns);
+        long long matches = 0;
+        std::function<void(int, long long)> on_match =
+            [&](int, long long) { matches++; };
+        PerfScope counters(state);
+        for (auto _ : state) {
+            int st = your_ahocorasick.initial_state();
+            for (size_t i = 0; i < file.size(); i += chunk_size) {
+                size_t len = std::min(chunk_size, file.size() - i);
+                st = your_ahocorasick.feed(
+                    st, Span<const char>(file.data() + i, len),
+                    (long long)(i), on_match);
+            }
+            ::benchmark::DoNotOptimize(st);
+        }
+        ::benchmark::DoNotOptimize(matches);
+        state.SetBytesProcessed(state.iterations() * n);
+    }
+
+    /// 長さ n のファイルを 64KiB ずつ読む
+    static void File(::benchmark::State& state) {
+        run(state, int(state.range(0)), 1 << 16);
+    }
+
+    /// 2^26 文字のファイルを state.range(0) 文字ずつ読む
+    static void ChunkSize(::benchmark::State& state) {
+        run(state, 1 << 26, size_t(state.range(0)));
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "File", File), 1 << 20, 1 << 28);
+        sizes(add(prefix, "ChunkSize", ChunkSize), 1 << 6, 1 << 20);
+        return true;
+    }
+};
+
+/**
+ * 辞書の大きさ m = state.range(0) (2^10 ~ 2^20) を変えて測る
+ * 文字列は長さ 2^24 ('a' ~ 'h'), パターンは長さ 4 ~ 12
+ */
+template <typename AC>
+struct AhoCorasickCountBench {
+    static constexpr int kTextLength = 1 << 24;
+
+    static const std::string& text() {
+        static const std::string t = [] {
+            algotest::random::Random gen;
+            std::string s(kTextLength, 'a');
+            for (auto& c : s)
+                c = char('a' + gen.uniform(0, 7));
+            return s;
+        }();
+        return t;
+    }
+
+    static std::vector<std::string> dictionary(int m) {
+        algotest::random::Random gen;
+        return ahocorasick::gen_dictionary(gen, text(), m, 12);
+    }
+
+    /**
+     * setup の時間, パターンあたりで出す
+     * trie のノード数 (nodes) と, 測れればノードあたりのバイト数 (bytes_per_node)
+     * (ALGOTEST_ALLOC_HOOKS() か memory_bytes() が必要, footprint.h) も出す
+     */
+    static void Build(::benchmark::State& state) {
+        int m = int(state.range(0));
+        auto patterns = dictionary(m);
+        double nodes = ahocorasick::Automaton(patterns).size();
+        {
+            AC your_ahocorasick;
+            auto fp = footprint::measure(
+                your_ahocorasick, [&] { your_ahocorasick.setup(patterns); });
+            if (fp.bytes() >= 0)
+                state.counters["bytes_per_node"] = double(fp.bytes()) / nodes;
+        }
+        state.counters["nodes"] = nodes;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            AC your_ahocorasick;
+            your_ahocorasick.setup(patterns);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * m);
+    }
+
+    static void Count(::benchmark::State& state) {
+        AC your_ahocorasick;
+        your_ahocorasick.setup(dictionary(int(state.range(0))));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto out = your_ahocorasick.count(text());
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetBytesProcessed(state.iterations() * kTextLength);
+    }
+
+    static void FirstMatch(::benchmark::State& state) {
+        AC your_ahocorasick;
+        your_ahocorasick.setup(dictionary(int(state.range(0))));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto out = your_ahocorasick.first_match(text());
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetBytesProcessed(state.iterations() * kTextLength);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Build", Build), 1 << 10, 1 << 20);
+        sizes(add(prefix, "Count", Count), 1 << 10, 1 << 20);
+        sizes(add(prefix, "FirstMatch", FirstMatch), 1 << 10, 1 << 20);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
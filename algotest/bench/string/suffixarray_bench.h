@@ -0,0 +1,131 @@
+#pragma once
+
+#include "../../string/suffixarray_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename SA>
+struct SuffixArrayBench {
+    static void SuffixArray(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        std::string s = gen.lower_string(n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            SA your_sa;
+            auto out = your_sa.sa(s);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static void run_sa(::benchmark::State& state, const std::string& s) {
+        PerfScope counters(state);
+        for (auto _ : state) {
+            SA your_sa;
+            auto out = your_sa.sa(s);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * s.size());
+    }
+
+    /// 同じ文字だけ
+    static void SARun(::benchmark::State& state) {
+        run_sa(state, suffixarray::gen_run(int(state.range(0))));
+    }
+
+    static void SAFibonacci(::benchmark::State& state) {
+        run_sa(state, suffixarray::gen_fibonacci(int(state.range(0))));
+    }
+
+    /// 周期 1000 の "acgt" 文字列 (少し変異あり)
+    static void SAPeriodicDNA(::benchmark::State& state) {
+        algotest::random::Random gen;
+        run_sa(state, suffixarray::gen_periodic_dna(int(state.range(0)),
+                                                    1000, gen));
+    }
+
+    static void LCP(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        std::string s = gen.lower_string(n);
+        auto sa = SA().sa(s);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            SA your_sa;
+            auto out = your_sa.lcp(s, sa);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    /// LCP のうち, 値渡しで s, sa をコピーする分 (SA は s のみ)
+    static void CopyInput(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        std::string s = gen.lower_string(n);
+        std::vector<int> sa(n + 1);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            std::string cs = s;
+            std::vector<int> csa = sa;
+            ::benchmark::DoNotOptimize(&cs[0]);
+            ::benchmark::DoNotOptimize(csa.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "SA", SuffixArray), 1 << 10, 1 << 22);
+        sizes(add(prefix, "SARun", SARun), 1 << 10, 1 << 24);
+        sizes(add(prefix, "SAFibonacci", SAFibonacci), 1 << 10, 1 << 24);
+        sizes(add(prefix, "SAPeriodicDNA", SAPeriodicDNA), 1 << 10, 1 << 24);
+        sizes(add(prefix, "LCP", LCP), 1 << 10, 1 << 22);
+        sizes(add(prefix, "CopyInput", CopyInput), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+/// const 参照 / Span で渡す版
+template <typename SA>
+struct SuffixArrayViewBench {
+    static void SuffixArray(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        std::string s = gen.lower_string(n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            SA your_sa;
+            auto out = your_sa.sa(s);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static void LCP(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        std::string s = gen.lower_string(n);
+        auto sa = SA().sa(s);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            SA your_sa;
+            auto out = your_sa.lcp(s, sa);
+            ::benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "SA", SuffixArray), 1 << 10, 1 << 22);
+        sizes(add(prefix, "LCP", LCP), 1 << 10, 1 << 22);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
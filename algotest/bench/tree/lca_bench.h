@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../../tree/lca_test.h"
+#include "../bench.h"
+
+namespace algotest {
+
+namespace bench {
+
+template <typename LCA>
+struct LCABench {
+    /// 頂点 i の親を [0, i) からランダムに選んだ木
+    static std::vector<std::vector<LCAEdge>> gen_tree(int n) {
+        algotest::random::Random gen;
+        std::vector<std::vector<LCAEdge>> g(n);
+        for (int i = 1; i < n; i++) {
+            int p = gen.uniform(0, i - 1);
+            g[i].push_back(LCAEdge{p});
+            g[p].push_back(LCAEdge{i});
+        }
+        return g;
+    }
+
+    static void Setup(::benchmark::State& state) {
+        int n = int(state.range(0));
+        auto g = gen_tree(n);
+        PerfScope counters(state);
+        for (auto _ : state) {
+            LCA your_lca;
+            your_lca.setup(g, 0);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    static void Query(::benchmark::State& state) {
+        int n = int(state.range(0));
+        algotest::random::Random gen;
+        LCA your_lca;
+        your_lca.setup(gen_tree(n), 0);
+        std::vector<std::pair<int, int>> qs(kQueryCount);
+        for (auto& q : qs) {
+            q = {gen.uniform(0, n - 1), gen.uniform(0, n - 1)};
+        }
+        size_t i = 0;
+        PerfScope counters(state);
+        for (auto _ : state) {
+            auto q = qs[i++ & (kQueryCount - 1)];
+            ::benchmark::DoNotOptimize(your_lca.query(q.first, q.second));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Setup", Setup), 1 << 10, 1 << 20);
+        sizes(add(prefix, "Query", Query), 1 << 10, 1 << 20);
+        return true;
+    }
+};
+
+/// 1 iteration で kQueryCount 個のクエリを1個ずつ / まとめて投げて比べる
+template <typename LCA>
+struct LCABatchBench {
+    struct Input {
+        LCA lca;
+        std::vector<int> u, v, out;
+    };
+
+    static void prepare(Input& in, int n) {
+        algotest::random::Random gen;
+        in.lca.setup(LCABench<LCA>::gen_tree(n), 0);
+        in.u.resize(kQueryCount);
+        in.v.resize(kQueryCount);
+        in.out.resize(kQueryCount);
+        for (int i = 0; i < kQueryCount; i++) {
+            in.u[i] = gen.uniform(0, n - 1);
+            in.v[i] = gen.uniform(0, n - 2);
+            if (in.v[i] >= in.u[i])
+                in.v[i]++;
+        }
+    }
+
+    static void Query(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            for (int i = 0; i < kQueryCount; i++) {
+                in.out[i] = in.lca.query(in.u[i], in.v[i]);
+            }
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static void QueryBatch(::benchmark::State& state) {
+        Input in;
+        prepare(in, int(state.range(0)));
+        PerfScope counters(state);
+        for (auto _ : state) {
+            in.lca.query_batch(in.u, in.v, in.out);
+            ::benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * kQueryCount);
+    }
+
+    static bool register_all(const std::string& prefix) {
+        sizes(add(prefix, "Query", Query), 1 << 10, 1 << 20);
+        sizes(add(prefix, "QueryBatch", QueryBatch), 1 << 10, 1 << 20);
+        return true;
+    }
+};
+
+}  // namespace bench
+
+}  // namespace algotest
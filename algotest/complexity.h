@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 実測による計算量の検査
+namespace algotest {
+
+namespace complexity {
+
+/// 宣言する計算量 (入力サイズ -> 手数)
+using Bound = double (*)(double);
+
+inline double linear(double n) {
+    return n;
+}
+
+inline double n_log_n(double n) {
+    return n * std::log2(std::max(n, 2.0));
+}
+
+/// 宣言した計算量から何乗ぶん余計に増えてよいか
+/// キャッシュミスの増加で 0.2 程度は出る, O(n log n) のつもりが O(n^2) なら 1 前後
+constexpr double kMaxExcess = 0.5;
+
+/// 1回の計測で最低限回す時間(秒)
+constexpr double kMinSec = 0.05;
+
+struct Sample {
+    double n;
+    double sec;
+};
+
+/// measure の中で計算した値を消されないよう書き込んでおく
+inline void keep(long long x) {
+    static volatile unsigned long long sink;
+    sink = sink + (unsigned long long)x;
+}
+
+/// fを(2回以上, 合計kMinSec以上)繰り返し呼び, 1回あたりの最短時間(秒)を返す
+template <class F>
+double measure(F f) {
+    using Clock = std::chrono::steady_clock;
+    double best = 1e100, total = 0;
+    for (int ph = 0; ph < 2 || total < kMinSec; ph++) {
+        auto st = Clock::now();
+        f();
+        double sec = std::chrono::duration<double>(Clock::now() - st).count();
+        best = std::min(best, sec);
+        total += sec;
+    }
+    return best;
+}
+
+/**
+ * log(sec / bound(n)) を log(n) に最小二乗で当てはめた傾きを返す
+ * 宣言通りの計算量ならほぼ0, 余計な n^k があれば k に近づく
+ */
+inline double excess_exponent(const std::vector<Sample>& samples,
+                              Bound bound) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    double k = double(samples.size());
+    for (auto s : samples) {
+        double x = std::log(s.n);
+        double y = std::log(s.sec / bound(s.n));
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    return (k * sxy - sx * sy) / (k * sxx - sx * sx);
+}
+
+/// 失敗時に出す計測結果の一覧
+inline std::string dump(const std::vector<Sample>& samples) {
+    std::ostringstream os;
+    for (auto s : samples) {
+        os << "n = " << s.n << ": " << s.sec * 1e3 << " ms\n";
+    }
+    return os.str();
+}
+
+}  // namespace complexity
+
+}  // namespace algotest
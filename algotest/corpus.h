@@ -0,0 +1,301 @@
+#pragma once
+
+#include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "span.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ALGOTEST_CORPUS_MMAP 1
+#endif
+
+/**
+ * 生成したテストケース(入力と期待される出力)のディスクキャッシュ
+ * (generator, parameters, seed, version) ごとに1ファイル, 2回目以降はmmapしてそのまま読む
+ * 生成方法を変えたら Key::version を上げること (上げないと古いファイルを読む)
+ * 環境変数 ALGOTEST_CORPUS_DIR (既存のディレクトリ) が設定されていなければ
+ * キャッシュせず毎回作る
+ *
+ * ファイル形式 (書いた環境のバイト順, 違う環境で読むと version が合わず作り直す):
+ *   Header {magic "ALGOTEST", version, section数}
+ *   Section {name[40], elem_size, count, offset} x section数
+ *   各sectionのデータ (64 byte境界に揃える)
+ */
+namespace algotest {
+
+namespace corpus {
+
+constexpr uint64_t kVersion = 1;
+constexpr size_t kAlign = 64;
+
+struct Key {
+    std::string generator;
+    std::vector<long long> params;
+    uint64_t seed;
+    /// 生成方法 (や参照実装) を変えたら上げる
+    uint64_t version = 1;
+
+    /// ファイル名に使える文字列
+    std::string str() const {
+        std::ostringstream os;
+        for (char c : generator) {
+            bool ok = isalnum((unsigned char)(c)) || c == '-' || c == '_';
+            os << (ok ? c : '_');
+        }
+        for (long long p : params) {
+            os << "_" << p;
+        }
+        os << "_s" << seed << "_v" << version;
+        return os.str();
+    }
+};
+
+struct Header {
+    char magic[8];
+    uint64_t version;
+    uint64_t sections;
+};
+
+struct Section {
+    char name[40];
+    uint64_t elem_size;
+    uint64_t count;
+    uint64_t offset;
+};
+
+/// キャッシュに書く配列を集める
+class Writer {
+  public:
+    template <class T>
+    void put(const std::string& name, const std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "corpus only stores trivially copyable types");
+        add(name, sizeof(T), v.size(), v.data());
+    }
+
+    void put(const std::string& name, const std::string& s) {
+        add(name, 1, s.size(), s.data());
+    }
+
+    /// ファイルに書く内容
+    std::vector<char> serialize() const {
+        size_t head = align(sizeof(Header) + sizeof(Section) * sections.size());
+        std::vector<char> buf(head + body.size());
+        Header h;
+        memcpy(h.magic, "ALGOTEST", 8);
+        h.version = kVersion;
+        h.sections = sections.size();
+        memcpy(buf.data(), &h, sizeof(h));
+        for (size_t i = 0; i < sections.size(); i++) {
+            Section s = sections[i];
+            s.offset += head;
+            memcpy(buf.data() + sizeof(Header) + sizeof(Section) * i, &s,
+                   sizeof(s));
+        }
+        if (!body.empty())
+            memcpy(buf.data() + head, body.data(), body.size());
+        return buf;
+    }
+
+  private:
+    std::vector<Section> sections;
+    /// 各sectionのデータを並べたもの, offset はここからの位置
+    std::vector<char> body;
+
+    static size_t align(size_t x) { return (x + kAlign - 1) / kAlign * kAlign; }
+
+    void add(const std::string& name,
+             size_t elem_size,
+             size_t count,
+             const void* ptr) {
+        Section s = {};
+        assert(name.size() < sizeof(s.name));
+        memcpy(s.name, name.data(), name.size());
+        s.elem_size = elem_size;
+        s.count = count;
+        s.offset = body.size();
+        sections.push_back(s);
+        const char* p = static_cast<const char*>(ptr);
+        body.insert(body.end(), p, p + elem_size * count);
+        body.resize(align(body.size()));
+    }
+};
+
+/// 読み込んだコーパス, get で中身を(コピーせずに)参照する
+class Corpus {
+  public:
+    Corpus() = default;
+
+    /// メモリ上のバッファから作る
+    static Corpus from_buffer(std::vector<char> buf) {
+        auto owner = std::make_shared<std::vector<char>>(std::move(buf));
+        Corpus c;
+        c.base = owner->data();
+        c.len = owner->size();
+        c.owner = owner;
+        return c;
+    }
+
+    /// ファイルから作る, 壊れていれば valid() が false
+    static Corpus from_file(const std::string& path) {
+        Corpus c;
+#ifdef ALGOTEST_CORPUS_MMAP
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return c;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close(fd);
+            return c;
+        }
+        size_t size = size_t(st.st_size);
+        void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED)
+            return c;
+        c.base = static_cast<const char*>(p);
+        c.len = size;
+        c.owner = std::shared_ptr<void>(p, [size](void* q) { munmap(q, size); });
+#else
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (!fp)
+            return c;
+        std::vector<char> buf;
+        char tmp[1 << 16];
+        size_t r;
+        while ((r = fread(tmp, 1, sizeof(tmp), fp)) > 0) {
+            buf.insert(buf.end(), tmp, tmp + r);
+        }
+        fclose(fp);
+        c = from_buffer(std::move(buf));
+#endif
+        if (!c.check())
+            return Corpus();
+        return c;
+    }
+
+    bool valid() const { return base != nullptr; }
+
+    /// name の配列, なければ (型が違えば) 例外を投げてテストを失敗させる
+    template <class T>
+    Span<const T> get(const std::string& name) const {
+        const Section* s = find(name);
+        if (!s || s->elem_size != sizeof(T))
+            throw std::runtime_error("corpus: no section \"" + name +
+                                     "\" of element size " +
+                                     std::to_string(sizeof(T)));
+        return Span<const T>(reinterpret_cast<const T*>(base + s->offset),
+                             size_t(s->count));
+    }
+
+    template <class T>
+    std::vector<T> get_vector(const std::string& name) const {
+        auto v = get<T>(name);
+        return std::vector<T>(v.begin(), v.end());
+    }
+
+    std::string get_string(const std::string& name) const {
+        auto v = get<char>(name);
+        return std::string(v.begin(), v.end());
+    }
+
+  private:
+    const char* base = nullptr;
+    size_t len = 0;
+    std::shared_ptr<void> owner;
+
+    const Header& header() const {
+        return *reinterpret_cast<const Header*>(base);
+    }
+
+    const Section& section(size_t i) const {
+        return *reinterpret_cast<const Section*>(base + sizeof(Header) +
+                                                 sizeof(Section) * i);
+    }
+
+    const Section* find(const std::string& name) const {
+        for (size_t i = 0; i < header().sections; i++) {
+            const Section& s = section(i);
+            if (strncmp(s.name, name.c_str(), sizeof(s.name)) == 0)
+                return &s;
+        }
+        return nullptr;
+    }
+
+    bool check() const {
+        if (len < sizeof(Header) || memcmp(header().magic, "ALGOTEST", 8) ||
+            header().version != kVersion)
+            return false;
+        size_t head = sizeof(Header) + sizeof(Section) * header().sections;
+        if (head > len)
+            return false;
+        for (size_t i = 0; i < header().sections; i++) {
+            const Section& s = section(i);
+            if (s.offset % kAlign || s.offset > len ||
+                s.elem_size * s.count > len - s.offset)
+                return false;
+        }
+        return true;
+    }
+};
+
+/// キャッシュの置き場所, 空ならキャッシュしない
+inline std::string cache_dir() {
+    const char* dir = std::getenv("ALGOTEST_CORPUS_DIR");
+    return dir ? std::string(dir) : std::string();
+}
+
+/**
+ * key のコーパスを読む, なければ build(Writer&) で作ってキャッシュする
+ * 同じ key なら全ての実装が同じバイト列を受け取る
+ * build の中で ASSERT_* / EXPECT_* が失敗したら (作りかけなので) キャッシュしない
+ */
+template <class F>
+Corpus load_or_build(const Key& key, F build) {
+    std::string dir = cache_dir();
+    std::string path = dir + "/" + key.str() + ".bin";
+    if (!dir.empty()) {
+        Corpus c = Corpus::from_file(path);
+        if (c.valid())
+            return c;
+    }
+    Writer w;
+    build(w);
+    std::vector<char> buf = w.serialize();
+    if (!dir.empty() && !::testing::Test::HasFailure()) {
+        // 書きかけのファイルを読まないように, 別名で書いてから rename する
+        std::string tmp =
+            path + ".tmp" + std::to_string(std::random_device()());
+        FILE* fp = fopen(tmp.c_str(), "wb");
+        if (fp) {
+            bool ok = fwrite(buf.data(), 1, buf.size(), fp) == buf.size();
+            ok &= fclose(fp) == 0;
+            if (ok && std::rename(tmp.c_str(), path.c_str()) == 0) {
+                Corpus c = Corpus::from_file(path);
+                if (c.valid())
+                    return c;
+            }
+            std::remove(tmp.c_str());
+        }
+    }
+    return Corpus::from_buffer(std::move(buf));
+}
+
+}  // namespace corpus
+
+}  // namespace algotest
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <vector>
+#include "../span.h"
 
 namespace algotest {
 
@@ -14,9 +15,48 @@ class FenwickTesterBase {
     virtual long long sum(int l, int r) = 0;
 };
 
+/// sum をまとめて投げる版
+class FenwickBatchTesterBase {
+    // 最初に1回, 初期状態の数列(0 <= a[i] <= 1e9)
+    virtual void setup(std::vector<long long> a) = 0;
+    // a[k] += x (0 <= x <= 1e9)
+    virtual void add(int k, long long x) = 0;
+    // a[l] + ... + a[r-1] (0 <= l <= r <= n)
+    virtual long long sum(int l, int r) = 0;
+    // out[i] = sum(l[i], r[i]), 各 Span の長さは等しい
+    virtual void sum_batch(Span<const int> l,
+                           Span<const int> r,
+                           Span<long long> out) = 0;
+};
+
+/// 区間加算・区間和の版
+class FenwickRangeTesterBase {
+    // 最初に1回, 初期状態の数列(0 <= a[i] <= 1e9), O(n) で構築すること
+    virtual void setup(Span<const long long> a) = 0;
+    // a[l], ..., a[r-1] += x (0 <= l <= r <= n, 0 <= x <= 1e9)
+    // 全体の和が long long に収まる範囲でしか呼ばれない
+    virtual void add(int l, int r, long long x) = 0;
+    // a[l] + ... + a[r-1] (0 <= l <= r <= n)
+    virtual long long sum(int l, int r) = 0;
+};
+
+/// 2次元の版, 一点加算・長方形和
+class Fenwick2DTesterBase {
+    // 最初に1回, h x w の初期状態 (a[y * w + x], 0 <= a[i] <= 1e9)
+    // O(hw) で構築すること
+    virtual void setup(int h, int w, Span<const long long> a) = 0;
+    // a[y][x] += v (0 <= v <= 1e9)
+    virtual void add(int y, int x, long long v) = 0;
+    // y1 <= y < y2, x1 <= x < x2 の a[y][x] の和
+    // (0 <= y1 <= y2 <= h, 0 <= x1 <= x2 <= w)
+    virtual long long sum(int y1, int x1, int y2, int x2) = 0;
+};
+
 }  // namespace algotest
 
+#include "../alloc.h"
 #include "../random.h"
+#include "../shard.h"
 #include "gtest/gtest.h"
 
 namespace algotest {
@@ -44,9 +84,109 @@ struct FenwickNaive {
     }
 };
 
+namespace fenwick {
+
+/**
+ * 大きいテスト用の参照実装, 区間加算・区間和
+ * 初期値は累積和で持ち, 加算分だけを2本の BIT で持つ (構築 O(n))
+ */
+struct RangeFenwick {
+    using ll = long long;
+    int n;
+    std::vector<ll> pre, b1, b2;
+
+    RangeFenwick(Span<const long long> a)
+        : n(int(a.size())), pre(n + 1), b1(n), b2(n) {
+        for (int i = 0; i < n; i++)
+            pre[i + 1] = pre[i] + a[i];
+    }
+
+    static void bit_add(std::vector<ll>& b, int k, ll x) {
+        for (; k < int(b.size()); k |= k + 1)
+            b[k] += x;
+    }
+    /// b[0] + ... + b[k-1]
+    static ll bit_sum(const std::vector<ll>& b, int k) {
+        ll s = 0;
+        for (k--; k >= 0; k = (k & (k + 1)) - 1)
+            s += b[k];
+        return s;
+    }
+    /// a[0] + ... + a[k-1]
+    ll prefix(int k) const {
+        return pre[k] + bit_sum(b1, k) * k - bit_sum(b2, k);
+    }
+
+    void add(int l, int r, ll x) {
+        bit_add(b1, l, x);
+        bit_add(b1, r, -x);
+        bit_add(b2, l, x * l);
+        bit_add(b2, r, -x * r);
+    }
+    ll sum(int l, int r) const { return prefix(r) - prefix(l); }
+};
+
+/// 大きいテスト用の参照実装, 2次元 BIT (構築 O(hw))
+struct Fenwick2D {
+    using ll = long long;
+    int h, w;
+    std::vector<ll> t;
+
+    Fenwick2D(int _h, int _w, Span<const long long> a)
+        : h(_h), w(_w), t(a.begin(), a.end()) {
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                int nx = x | (x + 1);
+                if (nx < w)
+                    t[size_t(y) * w + nx] += t[size_t(y) * w + x];
+            }
+        }
+        for (int y = 0; y < h; y++) {
+            int ny = y | (y + 1);
+            if (ny >= h)
+                continue;
+            for (int x = 0; x < w; x++) {
+                t[size_t(ny) * w + x] += t[size_t(y) * w + x];
+            }
+        }
+    }
+
+    void add(int y, int x, ll v) {
+        for (int i = y; i < h; i |= i + 1) {
+            for (int j = x; j < w; j |= j + 1)
+                t[size_t(i) * w + j] += v;
+        }
+    }
+    /// y < ry, x < rx の和
+    ll prefix(int ry, int rx) const {
+        ll s = 0;
+        for (int i = ry - 1; i >= 0; i = (i & (i + 1)) - 1) {
+            for (int j = rx - 1; j >= 0; j = (j & (j + 1)) - 1)
+                s += t[size_t(i) * w + j];
+        }
+        return s;
+    }
+    ll sum(int y1, int x1, int y2, int x2) const {
+        return prefix(y2, x2) - prefix(y1, x2) - prefix(y2, x1) +
+               prefix(y1, x1);
+    }
+};
+
+/// [0, n] から l <= r を選ぶ
+inline std::pair<int, int> gen_range(random::Random& gen, int n) {
+    int l = gen.uniform(0, n);
+    int r = gen.uniform(0, n);
+    if (l > r)
+        std::swap(l, r);
+    return {l, r};
+}
+
+}  // namespace fenwick
+
+/// 100ケース, 複数スレッドで回す (shard.h)
 TYPED_TEST_P(FenwickTest, StressTest) {
-    auto gen = algotest::random::Random();
-    for (int tc = 0; tc < 100; tc++) {
+    shard::run("FenwickTest.StressTest", 100, [](random::Random& gen,
+                                                 long long) {
         TypeParam your_fenwick;
         int n = gen.uniform(1, 100);
         std::vector<long long> v(n);
@@ -73,9 +213,258 @@ TYPED_TEST_P(FenwickTest, StressTest) {
                 EXPECT_EQ(your_fenwick.sum(a, b), fw.sum(a, b));
             }
         }
+    });
+}
+
+/// n = 10^7, 10^6 回の add / sum を参照実装と比べる
+TYPED_TEST_P(FenwickTest, LargeStressTest) {
+    auto gen = algotest::random::Random();
+    int n = 10000000, q = 1000000;
+    std::vector<long long> a = gen.uniform_vector(n, 0LL, 1000000000LL);
+    fenwick::RangeFenwick fw(a);
+    TypeParam your_fenwick;
+    your_fenwick.setup(a);
+    for (int ph = 0; ph < q; ph++) {
+        if (gen.uniform_bool()) {
+            int k = gen.uniform(0, n - 1);
+            long long x = gen.uniform(0, 1000000000);
+            your_fenwick.add(k, x);
+            fw.add(k, k + 1, x);
+        } else {
+            auto lr = fenwick::gen_range(gen, n);
+            ASSERT_EQ(fw.sum(lr.first, lr.second),
+                      your_fenwick.sum(lr.first, lr.second))
+                << "l = " << lr.first << ", r = " << lr.second;
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(FenwickTest, StressTest, LargeStressTest);
+
+template <typename FENWICK>
+class FenwickAllocTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(FenwickAllocTest);
+
+/// add, sum はメモリを確保しない (ALGOTEST_ALLOC_HOOKS() がなければ何もしない)
+TYPED_TEST_P(FenwickAllocTest, QueryTest) {
+    if (!alloc::installed())
+        return;
+    auto gen = algotest::random::Random();
+    int n = 100000;
+    TypeParam your_fenwick;
+    your_fenwick.setup(gen.uniform_vector(n, 0LL, 1000000000LL));
+    std::vector<int> ks = gen.uniform_vector(n, 0, n - 1);
+    std::vector<long long> xs = gen.uniform_vector(n, 0LL, 1000000000LL);
+    std::vector<std::pair<int, int>> qs(n);
+    for (auto& q : qs) {
+        int l = gen.uniform(0, n);
+        int r = gen.uniform(0, n);
+        if (l > r)
+            std::swap(l, r);
+        q = {l, r};
+    }
+    long long sum = 0;
+    alloc::Stats st = alloc::measure([&] {
+        for (int i = 0; i < n; i++) {
+            your_fenwick.add(ks[i], xs[i]);
+            sum += your_fenwick.sum(qs[i].first, qs[i].second);
+        }
+    });
+    ASSERT_EQ(0u, st.count) << alloc::dump(st) << " (sum = " << sum << ")";
+}
+
+REGISTER_TYPED_TEST_CASE_P(FenwickAllocTest, QueryTest);
+
+template <typename FENWICK>
+class FenwickBatchTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(FenwickBatchTest);
+
+/// add と sum_batch を交互に呼んで愚直解と比べる
+TYPED_TEST_P(FenwickBatchTest, StressTest) {
+    auto gen = algotest::random::Random();
+    for (int tc = 0; tc < 100; tc++) {
+        TypeParam your_fenwick;
+        int n = gen.uniform(1, 100);
+        std::vector<long long> v = gen.uniform_vector(n, 0LL, 1000000000LL);
+        your_fenwick.setup(v);
+        FenwickNaive fw(v);
+        for (int ph = 0; ph < 10; ph++) {
+            int k = gen.uniform(0, n - 1);
+            long long x = gen.uniform(0, 1000000000);
+            your_fenwick.add(k, x);
+            fw.add(k, x);
+            int q = gen.uniform(0, 20);
+            std::vector<int> ls(q), rs(q);
+            std::vector<long long> out(q, -1);
+            for (int i = 0; i < q; i++) {
+                int l = gen.uniform(0, n);
+                int r = gen.uniform(0, n);
+                if (l > r)
+                    std::swap(l, r);
+                ls[i] = l;
+                rs[i] = r;
+            }
+            your_fenwick.sum_batch(ls, rs, out);
+            for (int i = 0; i < q; i++) {
+                ASSERT_EQ(fw.sum(ls[i], rs[i]), out[i])
+                    << "l = " << ls[i] << ", r = " << rs[i];
+            }
+        }
+    }
+}
+
+/// n = 10^6, 10^6 クエリを1回のバッチで投げて sum と比べる
+TYPED_TEST_P(FenwickBatchTest, LargeTest) {
+    auto gen = algotest::random::Random();
+    int n = 1000000, q = 1000000;
+    TypeParam your_fenwick;
+    your_fenwick.setup(gen.uniform_vector(n, 0LL, 1000000000LL));
+    for (int i = 0; i < n; i++) {
+        your_fenwick.add(gen.uniform(0, n - 1), gen.uniform(0, 1000000000));
+    }
+    std::vector<int> ls(q), rs(q);
+    std::vector<long long> out(q, -1);
+    for (int i = 0; i < q; i++) {
+        int l = gen.uniform(0, n);
+        int r = gen.uniform(0, n);
+        if (l > r)
+            std::swap(l, r);
+        ls[i] = l;
+        rs[i] = r;
+    }
+    your_fenwick.sum_batch(ls, rs, out);
+    for (int i = 0; i < q; i++) {
+        ASSERT_EQ(your_fenwick.sum(ls[i], rs[i]), out[i])
+            << "l = " << ls[i] << ", r = " << rs[i];
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(FenwickBatchTest, StressTest, LargeTest);
+
+template <typename FENWICK>
+class FenwickRangeTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(FenwickRangeTest);
+
+/// 100ケース, 愚直解と比べる
+TYPED_TEST_P(FenwickRangeTest, StressTest) {
+    shard::run("FenwickRangeTest.StressTest", 100, [](random::Random& gen,
+                                                      long long) {
+        int n = gen.uniform(1, 100);
+        std::vector<long long> a = gen.uniform_vector(n, 0LL, 1000000000LL);
+        TypeParam your_fenwick;
+        your_fenwick.setup(a);
+        int q = gen.uniform(1, 100);
+        for (int ph = 0; ph < q; ph++) {
+            auto lr = fenwick::gen_range(gen, n);
+            if (gen.uniform_bool()) {
+                long long x = gen.uniform(0, 1000000000);
+                your_fenwick.add(lr.first, lr.second, x);
+                for (int i = lr.first; i < lr.second; i++)
+                    a[i] += x;
+            } else {
+                long long expect = 0;
+                for (int i = lr.first; i < lr.second; i++)
+                    expect += a[i];
+                ASSERT_EQ(expect, your_fenwick.sum(lr.first, lr.second))
+                    << "l = " << lr.first << ", r = " << lr.second;
+            }
+        }
+    });
+}
+
+/// n = 10^7, 10^6 回の add / sum を参照実装と比べる
+TYPED_TEST_P(FenwickRangeTest, LargeStressTest) {
+    auto gen = algotest::random::Random();
+    int n = 10000000, q = 1000000;
+    std::vector<long long> a = gen.uniform_vector(n, 0LL, 1000000000LL);
+    fenwick::RangeFenwick fw(a);
+    TypeParam your_fenwick;
+    your_fenwick.setup(a);
+    for (int ph = 0; ph < q; ph++) {
+        auto lr = fenwick::gen_range(gen, n);
+        if (gen.uniform_bool()) {
+            // 和が long long に収まるよう x は小さめ
+            long long x = gen.uniform(0, 1000);
+            your_fenwick.add(lr.first, lr.second, x);
+            fw.add(lr.first, lr.second, x);
+        } else {
+            ASSERT_EQ(fw.sum(lr.first, lr.second),
+                      your_fenwick.sum(lr.first, lr.second))
+                << "l = " << lr.first << ", r = " << lr.second;
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(FenwickRangeTest, StressTest, LargeStressTest);
+
+template <typename FENWICK>
+class Fenwick2DTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(Fenwick2DTest);
+
+/// 100ケース, h, w <= 20 で愚直解と比べる
+TYPED_TEST_P(Fenwick2DTest, StressTest) {
+    shard::run("Fenwick2DTest.StressTest", 100, [](random::Random& gen,
+                                                   long long) {
+        int h = gen.uniform(1, 20), w = gen.uniform(1, 20);
+        std::vector<long long> a =
+            gen.uniform_vector(size_t(h) * w, 0LL, 1000000000LL);
+        TypeParam your_fenwick;
+        your_fenwick.setup(h, w, a);
+        int q = gen.uniform(1, 100);
+        for (int ph = 0; ph < q; ph++) {
+            if (gen.uniform_bool()) {
+                int y = gen.uniform(0, h - 1), x = gen.uniform(0, w - 1);
+                long long v = gen.uniform(0, 1000000000);
+                your_fenwick.add(y, x, v);
+                a[y * w + x] += v;
+            } else {
+                auto ys = fenwick::gen_range(gen, h);
+                auto xs = fenwick::gen_range(gen, w);
+                long long expect = 0;
+                for (int y = ys.first; y < ys.second; y++) {
+                    for (int x = xs.first; x < xs.second; x++)
+                        expect += a[y * w + x];
+                }
+                ASSERT_EQ(expect, your_fenwick.sum(ys.first, xs.first,
+                                                   ys.second, xs.second))
+                    << "y = [" << ys.first << ", " << ys.second << "), x = ["
+                    << xs.first << ", " << xs.second << ")";
+            }
+        }
+    });
+}
+
+/// 4096 x 4096, 10^6 回の add / sum を参照実装と比べる
+TYPED_TEST_P(Fenwick2DTest, LargeStressTest) {
+    auto gen = algotest::random::Random();
+    int h = 4096, w = 4096, q = 1000000;
+    std::vector<long long> a =
+        gen.uniform_vector(size_t(h) * w, 0LL, 1000000000LL);
+    fenwick::Fenwick2D fw(h, w, a);
+    TypeParam your_fenwick;
+    your_fenwick.setup(h, w, a);
+    for (int ph = 0; ph < q; ph++) {
+        if (gen.uniform_bool()) {
+            int y = gen.uniform(0, h - 1), x = gen.uniform(0, w - 1);
+            long long v = gen.uniform(0, 1000000000);
+            your_fenwick.add(y, x, v);
+            fw.add(y, x, v);
+        } else {
+            auto ys = fenwick::gen_range(gen, h);
+            auto xs = fenwick::gen_range(gen, w);
+            ASSERT_EQ(fw.sum(ys.first, xs.first, ys.second, xs.second),
+                      your_fenwick.sum(ys.first, xs.first, ys.second,
+                                       xs.second))
+                << "y = [" << ys.first << ", " << ys.second << "), x = ["
+                << xs.first << ", " << xs.second << ")";
+        }
     }
 }
 
-REGISTER_TYPED_TEST_CASE_P(FenwickTest, StressTest);
+REGISTER_TYPED_TEST_CASE_P(Fenwick2DTest, StressTest, LargeStressTest);
 
 }  // namespace algotest
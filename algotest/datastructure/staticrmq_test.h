@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <vector>
+#include "../span.h"
 
 namespace algotest {
 
@@ -10,11 +11,37 @@ class StaticRMQTesterBase {
     virtual void setup(std::vector<int> a) = 0;
     // min(a[l], ...  ,a[r-1]) (0 <= l < r <= n)
     virtual int range_min(int l, int r) = 0;
+    // (任意) 使っているバイト数, あれば StaticRMQMemoryTest が記録する
+    // size_t memory_bytes();
+};
+
+/// 数列をコピーせずに受け取る版
+class StaticRMQViewTesterBase {
+    // 最初に1回, 初期状態の数列(0 <= a[i] <= 1e9)
+    // a の中身は range_min を呼び終わるまで変わらずに残っている
+    virtual void setup(Span<const int> a) = 0;
+    // min(a[l], ...  ,a[r-1]) (0 <= l < r <= n)
+    virtual int range_min(int l, int r) = 0;
+};
+
+/// クエリをまとめて投げる版
+class StaticRMQBatchTesterBase {
+    // 最初に1回, 初期状態の数列(0 <= a[i] <= 1e9)
+    virtual void setup(std::vector<int> a) = 0;
+    // min(a[l], ...  ,a[r-1]) (0 <= l < r <= n)
+    virtual int range_min(int l, int r) = 0;
+    // out[i] = range_min(l[i], r[i]), 各 Span の長さは等しい
+    virtual void range_min_batch(Span<const int> l,
+                                 Span<const int> r,
+                                 Span<int> out) = 0;
 };
 
 }  // namespace algotest
 
+#include "../alloc.h"
+#include "../footprint.h"
 #include "../random.h"
+#include "../shard.h"
 #include "gtest/gtest.h"
 
 namespace algotest {
@@ -24,9 +51,10 @@ class StaticRMQTest : public ::testing::Test {};
 
 TYPED_TEST_CASE_P(StaticRMQTest);
 
+/// 100ケース, 複数スレッドで回す (shard.h)
 TYPED_TEST_P(StaticRMQTest, StressTest) {
-    auto gen = algotest::random::Random();
-    for (int tc = 0; tc < 100; tc++) {
+    shard::run("StaticRMQTest.StressTest", 100, [](random::Random& gen,
+                                                   long long) {
         TypeParam your_rmq;
         int n = gen.uniform(1, 100);
         std::vector<int> a(n);
@@ -42,9 +70,196 @@ TYPED_TEST_P(StaticRMQTest, StressTest) {
                 ASSERT_EQ(mi, your_rmq.range_min(l, r));
             }
         }
-    }
+    });
 }
 
 REGISTER_TYPED_TEST_CASE_P(StaticRMQTest, StressTest);
 
+template <typename RMQ>
+class StaticRMQAllocTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(StaticRMQAllocTest);
+
+/// range_min はメモリを確保しない (ALGOTEST_ALLOC_HOOKS() がなければ何もしない)
+TYPED_TEST_P(StaticRMQAllocTest, QueryTest) {
+    if (!alloc::installed())
+        return;
+    auto gen = algotest::random::Random();
+    int n = 100000;
+    TypeParam your_rmq;
+    your_rmq.setup(gen.uniform_vector(n, 0, 1000000000));
+    std::vector<std::pair<int, int>> qs(n);
+    for (auto& q : qs) {
+        int l = gen.uniform(0, n - 1);
+        int r = gen.uniform(0, n - 1);
+        if (l > r)
+            std::swap(l, r);
+        q = {l, r + 1};
+    }
+    long long sum = 0;
+    alloc::Stats st = alloc::measure([&] {
+        for (auto q : qs) {
+            sum += your_rmq.range_min(q.first, q.second);
+        }
+    });
+    ASSERT_EQ(0u, st.count) << alloc::dump(st) << " (sum = " << sum << ")";
+}
+
+REGISTER_TYPED_TEST_CASE_P(StaticRMQAllocTest, QueryTest);
+
+template <typename RMQ>
+class StaticRMQBatchTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(StaticRMQBatchTest);
+
+/// range_min_batch を愚直解と比べる, 空のバッチも含む
+TYPED_TEST_P(StaticRMQBatchTest, StressTest) {
+    auto gen = algotest::random::Random();
+    for (int tc = 0; tc < 100; tc++) {
+        TypeParam your_rmq;
+        int n = gen.uniform(1, 100);
+        std::vector<int> a = gen.uniform_vector(n, 0, 1000000000);
+        your_rmq.setup(a);
+        int q = gen.uniform(0, 100);
+        std::vector<int> ls(q), rs(q), out(q, -1);
+        for (int i = 0; i < q; i++) {
+            int l = gen.uniform(0, n - 1);
+            int r = gen.uniform(0, n - 1);
+            if (l > r)
+                std::swap(l, r);
+            ls[i] = l;
+            rs[i] = r + 1;
+        }
+        your_rmq.range_min_batch(ls, rs, out);
+        for (int i = 0; i < q; i++) {
+            ASSERT_EQ(*std::min_element(a.begin() + ls[i], a.begin() + rs[i]),
+                      out[i])
+                << "l = " << ls[i] << ", r = " << rs[i];
+        }
+    }
+}
+
+/// n = 10^6, 10^6 クエリを1回のバッチで投げて range_min と比べる
+TYPED_TEST_P(StaticRMQBatchTest, LargeTest) {
+    auto gen = algotest::random::Random();
+    int n = 1000000, q = 1000000;
+    TypeParam your_rmq;
+    your_rmq.setup(gen.uniform_vector(n, 0, 1000000000));
+    std::vector<int> ls(q), rs(q), out(q, -1);
+    for (int i = 0; i < q; i++) {
+        // 短い区間と長い区間を半々
+        int l = gen.uniform(0, n - 1);
+        int r = i % 2 ? std::min(n - 1, l + gen.uniform(0, 16))
+                      : gen.uniform(0, n - 1);
+        if (l > r)
+            std::swap(l, r);
+        ls[i] = l;
+        rs[i] = r + 1;
+    }
+    your_rmq.range_min_batch(ls, rs, out);
+    for (int i = 0; i < q; i++) {
+        ASSERT_EQ(your_rmq.range_min(ls[i], rs[i]), out[i])
+            << "l = " << ls[i] << ", r = " << rs[i];
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(StaticRMQBatchTest, StressTest, LargeTest);
+
+template <typename RMQ>
+class StaticRMQViewTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(StaticRMQViewTest);
+
+TYPED_TEST_P(StaticRMQViewTest, StressTest) {
+    auto gen = algotest::random::Random();
+    for (int tc = 0; tc < 100; tc++) {
+        TypeParam your_rmq;
+        int n = gen.uniform(1, 100);
+        std::vector<int> a = gen.uniform_vector(n, 0, 1000000000);
+        your_rmq.setup(a);
+        for (int l = 0; l < n; l++) {
+            int mi = a[l];
+            for (int r = l + 1; r <= n; r++) {
+                mi = std::min(mi, a[r - 1]);
+                ASSERT_EQ(mi, your_rmq.range_min(l, r));
+            }
+        }
+    }
+}
+
+/// n = 10^7, 長さ 2^k 付近の区間に 10^6 クエリ
+TYPED_TEST_P(StaticRMQViewTest, LargeTest) {
+    auto gen = algotest::random::Random();
+    const int n = 10000000, q = 1000000, B = 64;
+    std::vector<int> a = gen.uniform_vector(n, 0, 1000000000);
+    // 答えは長さ B のブロックの中の接頭辞 / 接尾辞の最小値と,
+    // ブロックごとの最小値の Sparse Table で O(1) (同じブロック内なら O(B)) で求める
+    const int m = (n + B - 1) / B;
+    std::vector<int> pre(n), suf(n);
+    for (int i = 0; i < n; i++) {
+        pre[i] = (i % B) ? std::min(pre[i - 1], a[i]) : a[i];
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        suf[i] = (i % B != B - 1 && i + 1 < n) ? std::min(suf[i + 1], a[i])
+                                                : a[i];
+    }
+    std::vector<std::vector<int>> table(1, std::vector<int>(m));
+    for (int i = 0; i < m; i++) {
+        table[0][i] = suf[i * B];
+    }
+    for (int k = 1; (1 << k) <= m; k++) {
+        const auto& prev = table[k - 1];
+        std::vector<int> cur(m - (1 << k) + 1);
+        for (size_t i = 0; i < cur.size(); i++) {
+            cur[i] = std::min(prev[i], prev[i + (1 << (k - 1))]);
+        }
+        table.push_back(std::move(cur));
+    }
+    auto answer = [&](int l, int r) {
+        int bl = l / B, br = (r - 1) / B;
+        if (bl == br)
+            return *std::min_element(a.begin() + l, a.begin() + r);
+        int mi = std::min(suf[l], pre[r - 1]);
+        if (bl + 1 < br) {
+            int k = 31 - __builtin_clz(br - bl - 1);
+            mi = std::min({mi, table[k][bl + 1], table[k][br - (1 << k)]});
+        }
+        return mi;
+    };
+    TypeParam your_rmq;
+    your_rmq.setup(a);
+    for (int i = 0; i < q; i++) {
+        int len = (1 << gen.uniform(0, 23)) + gen.uniform(-1, 1);
+        len = std::max(1, std::min(n, len));
+        int l = gen.uniform(0, n - len);
+        int r = l + len;
+        ASSERT_EQ(answer(l, r), your_rmq.range_min(l, r))
+            << "l = " << l << ", r = " << r;
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(StaticRMQViewTest, StressTest, LargeTest);
+
+template <typename RMQ>
+class StaticRMQMemoryTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(StaticRMQMemoryTest);
+
+/// n = 10^6, 10^7, 10^8 (footprint::max_n() まで) で setup 後のメモリを記録する
+TYPED_TEST_P(StaticRMQMemoryTest, FootprintTest) {
+    auto gen = algotest::random::Random();
+    for (int n = 1000000; n <= 100000000 && n <= footprint::max_n();
+         n *= 10) {
+        std::vector<int> a = gen.uniform_vector(n, 0, 1000000000);
+        TypeParam your_rmq;
+        auto fp = footprint::measure(your_rmq, [&] { your_rmq.setup(a); });
+        footprint::record("n_" + std::to_string(n), fp, n);
+        // 壊れていないことだけ確かめる
+        ASSERT_EQ(*std::min_element(a.begin(), a.end()),
+                  your_rmq.range_min(0, n));
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(StaticRMQMemoryTest, FootprintTest);
+
 }  // namespace algotest
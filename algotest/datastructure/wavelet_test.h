@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <vector>
+#include "../span.h"
 
 namespace algotest {
 
@@ -12,10 +13,34 @@ class WaveletTesterBase {
     virtual int rank(int l, int r, int x) = 0;
     // a[l] ~ a[r-1]で，k番目の値を返す (0 <= k < r-l)
     virtual int select(int l, int r, int k) = 0;
+    // (任意) 使っているバイト数, あれば WaveletMemoryTest が記録する
+    // size_t memory_bytes();
+};
+
+/// rank, select をまとめて投げる版
+class WaveletBatchTesterBase {
+    // 最初に1回, 0 <= a_i < n, permとは限らない
+    virtual void setup(std::vector<int> a) = 0;
+    // a[l] ~ a[r-1]で，xより小さいものの個数を返す
+    virtual int rank(int l, int r, int x) = 0;
+    // a[l] ~ a[r-1]で，k番目の値を返す (0 <= k < r-l)
+    virtual int select(int l, int r, int k) = 0;
+    // out[i] = rank(l[i], r[i], x[i]), 各 Span の長さは等しい
+    virtual void rank_batch(Span<const int> l,
+                            Span<const int> r,
+                            Span<const int> x,
+                            Span<int> out) = 0;
+    // out[i] = select(l[i], r[i], k[i]), 各 Span の長さは等しい
+    virtual void select_batch(Span<const int> l,
+                              Span<const int> r,
+                              Span<const int> k,
+                              Span<int> out) = 0;
 };
 
 }  // namespace algotest
 
+#include "../alloc.h"
+#include "../footprint.h"
 #include "../random.h"
 #include "gtest/gtest.h"
 
@@ -99,4 +124,133 @@ TYPED_TEST_P(WaveletTest, SelectStressTest) {
 
 REGISTER_TYPED_TEST_CASE_P(WaveletTest, RankStressTest, SelectStressTest);
 
+template <typename WAVELET>
+class WaveletAllocTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(WaveletAllocTest);
+
+/// rank, select はメモリを確保しない (ALGOTEST_ALLOC_HOOKS() がなければ何もしない)
+TYPED_TEST_P(WaveletAllocTest, QueryTest) {
+    if (!alloc::installed())
+        return;
+    auto gen = algotest::random::Random();
+    int n = 100000;
+    TypeParam your_wavelet;
+    your_wavelet.setup(gen.uniform_vector(n, 0, n - 1));
+    std::vector<int> ls(n), rs(n), ks(n), xs = gen.uniform_vector(n, 0, n);
+    for (int i = 0; i < n; i++) {
+        int l = gen.uniform(0, n - 1);
+        int r = gen.uniform(0, n - 1);
+        if (l > r)
+            std::swap(l, r);
+        ls[i] = l;
+        rs[i] = r + 1;
+        ks[i] = gen.uniform(0, r - l);
+    }
+    long long sum = 0;
+    alloc::Stats st = alloc::measure([&] {
+        for (int i = 0; i < n; i++) {
+            sum += your_wavelet.rank(ls[i], rs[i], xs[i]);
+            sum += your_wavelet.select(ls[i], rs[i], ks[i]);
+        }
+    });
+    ASSERT_EQ(0u, st.count) << alloc::dump(st) << " (sum = " << sum << ")";
+}
+
+REGISTER_TYPED_TEST_CASE_P(WaveletAllocTest, QueryTest);
+
+template <typename WAVELET>
+class WaveletBatchTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(WaveletBatchTest);
+
+/// rank_batch, select_batch を愚直解と比べる
+TYPED_TEST_P(WaveletBatchTest, StressTest) {
+    auto gen = algotest::random::Random();
+    for (int tc = 0; tc < 100; tc++) {
+        TypeParam your_wavelet;
+        int n = gen.uniform(1, 100);
+        std::vector<int> v = gen.uniform_vector(n, 0, n - 1);
+        your_wavelet.setup(v);
+        WaveletNaive wt(v);
+        int q = gen.uniform(0, 100);
+        std::vector<int> ls(q), rs(q), xs(q), ks(q);
+        for (int i = 0; i < q; i++) {
+            int l = gen.uniform(0, n - 1);
+            int r = gen.uniform(0, n - 1);
+            if (l > r)
+                std::swap(l, r);
+            ls[i] = l;
+            rs[i] = r + 1;
+            xs[i] = gen.uniform(0, n);
+            ks[i] = gen.uniform(0, r - l);
+        }
+        std::vector<int> rank_out(q, -1), select_out(q, -1);
+        your_wavelet.rank_batch(ls, rs, xs, rank_out);
+        your_wavelet.select_batch(ls, rs, ks, select_out);
+        for (int i = 0; i < q; i++) {
+            ASSERT_EQ(wt.rank(ls[i], rs[i], xs[i]), rank_out[i]);
+            ASSERT_EQ(wt.select(ls[i], rs[i], ks[i]), select_out[i]);
+        }
+    }
+}
+
+/// n = 10^6, 10^6 クエリを1回のバッチで投げて rank, select と比べる
+TYPED_TEST_P(WaveletBatchTest, LargeTest) {
+    auto gen = algotest::random::Random();
+    int n = 1000000, q = 1000000;
+    TypeParam your_wavelet;
+    your_wavelet.setup(gen.uniform_vector(n, 0, n - 1));
+    std::vector<int> ls(q), rs(q), xs = gen.uniform_vector(q, 0, n), ks(q);
+    for (int i = 0; i < q; i++) {
+        int l = gen.uniform(0, n - 1);
+        int r = gen.uniform(0, n - 1);
+        if (l > r)
+            std::swap(l, r);
+        ls[i] = l;
+        rs[i] = r + 1;
+        ks[i] = gen.uniform(0, r - l);
+    }
+    std::vector<int> rank_out(q, -1), select_out(q, -1);
+    your_wavelet.rank_batch(ls, rs, xs, rank_out);
+    your_wavelet.select_batch(ls, rs, ks, select_out);
+    for (int i = 0; i < q; i++) {
+        ASSERT_EQ(your_wavelet.rank(ls[i], rs[i], xs[i]), rank_out[i]);
+        ASSERT_EQ(your_wavelet.select(ls[i], rs[i], ks[i]), select_out[i]);
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(WaveletBatchTest, StressTest, LargeTest);
+
+template <typename WAVELET>
+class WaveletMemoryTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(WaveletMemoryTest);
+
+/**
+ * n = 10^6, 10^7, 10^8 (footprint::max_n() まで), 0 <= a_i < n で setup 後の
+ * メモリを測って記録する, n * ceil(log2 n) * 1.1 bit を超えたら失敗
+ * heap も memory_bytes() も取れなければ記録だけ (何もない) で終わる
+ */
+TYPED_TEST_P(WaveletMemoryTest, FootprintTest) {
+    auto gen = algotest::random::Random();
+    for (int n = 1000000; n <= 100000000 && n <= footprint::max_n();
+         n *= 10) {
+        std::vector<int> a = gen.uniform_vector(n, 0, n - 1);
+        int lg = 0;
+        while ((1 << lg) < n)
+            lg++;
+        TypeParam your_wavelet;
+        auto fp = footprint::measure(your_wavelet,
+                                     [&] { your_wavelet.setup(a); });
+        footprint::record("n_" + std::to_string(n), fp, n);
+        if (fp.bytes() < 0)
+            continue;
+        ASSERT_LE(8.0 * double(fp.bytes()), 1.1 * n * lg)
+            << footprint::dump(fp, n);
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(WaveletMemoryTest, FootprintTest);
+
 }  // namespace algotest
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "alloc.h"
+#include "shard.h"
+
+/**
+ * 候補実装のメモリ使用量を測る
+ *   - heap: setup の前後で生きているヒープの増分 + sizeof(T)
+ *           (ALGOTEST_ALLOC_HOOKS() があるときのみ, 一時領域は含まない)
+ *   - peak: setup 中に生きていたヒープの最大 (同上)
+ *   - reported: 候補実装が memory_bytes() を持っていればその値
+ * 取れなかった値は -1
+ */
+namespace algotest {
+
+namespace footprint {
+
+/// T が memory_bytes() を持つか
+template <class T, class = void>
+struct has_memory_bytes : std::false_type {};
+template <class T>
+struct has_memory_bytes<
+    T,
+    decltype(void(std::declval<T&>().memory_bytes()))> : std::true_type {};
+
+template <class T>
+long long reported_bytes(T& t, std::true_type) {
+    return (long long)(t.memory_bytes());
+}
+template <class T>
+long long reported_bytes(T&, std::false_type) {
+    return -1;
+}
+/// t.memory_bytes(), なければ -1
+template <class T>
+long long reported_bytes(T& t) {
+    return reported_bytes(t, has_memory_bytes<T>());
+}
+
+struct Footprint {
+    long long heap = -1, peak = -1, reported = -1;
+
+    /// 予算の判定に使う値, heap を優先する (どちらもなければ -1)
+    long long bytes() const { return heap >= 0 ? heap : reported; }
+};
+
+/// setup() を呼んで t の使用量を測る
+template <class T, class F>
+Footprint measure(T& t, F setup) {
+    Footprint fp;
+    if (alloc::installed()) {
+        size_t live0 = alloc::state().live;
+        alloc::Stats st = alloc::measure(setup);
+        fp.heap = (long long)(alloc::state().live - live0 + sizeof(T));
+        fp.peak = (long long)(st.peak);
+    } else {
+        setup();
+    }
+    fp.reported = reported_bytes(t);
+    return fp;
+}
+
+/// 1要素あたりのビット数 (bytes < 0 なら -1)
+inline double bits_per_element(long long bytes, long long n) {
+    return bytes < 0 ? -1 : 8.0 * double(bytes) / double(n);
+}
+
+/// 測る n の上限, 10^8 まで測るなら ALGOTEST_MEMORY_MAX_N=100000000
+inline long long max_n() {
+    return shard::env_int("ALGOTEST_MEMORY_MAX_N", 10000000);
+}
+
+/// 失敗時に出す文字列
+inline std::string dump(const Footprint& fp, long long n) {
+    std::ostringstream os;
+    os << "n = " << n << ", heap = " << fp.heap << " ("
+       << bits_per_element(fp.heap, n) << " bits/elem), peak = " << fp.peak
+       << ", reported = " << fp.reported << " ("
+       << bits_per_element(fp.reported, n) << " bits/elem)";
+    return os.str();
+}
+
+/// RecordProperty で key_heap_bits, key_reported_bits などを残す
+inline void record(const std::string& key, const Footprint& fp, long long n) {
+    auto put = [&](const std::string& name, double v) {
+        std::ostringstream os;
+        os << v;
+        ::testing::Test::RecordProperty(key + "_" + name, os.str());
+    };
+    if (fp.heap >= 0) {
+        put("heap_bits", bits_per_element(fp.heap, n));
+        put("peak_bits", bits_per_element(fp.peak, n));
+    }
+    if (fp.reported >= 0)
+        put("reported_bits", bits_per_element(fp.reported, n));
+}
+
+}  // namespace footprint
+
+}  // namespace algotest
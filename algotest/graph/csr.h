@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cassert>
+#include <vector>
+#include "../span.h"
+
+// 隣接リストを1本の配列に詰めたグラフ (Compressed Sparse Row)
+namespace algotest {
+
+namespace csr {
+
+/// 頂点 v から出る辺は to[start[v]] ~ to[start[v + 1] - 1]
+/// 辺数は 2^31 未満を想定
+struct CSR {
+    int n = 0;
+    std::vector<int> start = std::vector<int>(1, 0);
+    std::vector<int> to;
+    /// 重み, 重みなしグラフなら空
+    std::vector<long long> cost;
+
+    int edge_count() const { return int(to.size()); }
+    int degree(int v) const { return start[v + 1] - start[v]; }
+    bool weighted() const { return !cost.empty(); }
+};
+
+/**
+ * CSR (または同じ形の配列) の読み取り専用ビュー, コピーせずに渡す用
+ * 元の配列より長生きさせないこと
+ */
+struct CSRView {
+    int n = 0;
+    Span<const int> start, to;
+    /// 重み, 重みなしグラフなら空
+    Span<const long long> cost;
+
+    CSRView() = default;
+    CSRView(const CSR& g) : n(g.n), start(g.start), to(g.to), cost(g.cost) {}
+
+    int edge_count() const { return int(to.size()); }
+    int degree(int v) const { return start[v + 1] - start[v]; }
+    bool weighted() const { return !cost.empty(); }
+};
+
+/**
+ * 辺を2回列挙してCSRを作る, 辺リストは持たない
+ * each_edge(emit) は emit(from, to) を全ての辺について同じ順で呼ぶこと
+ */
+template <class F>
+CSR build(int n, F each_edge) {
+    CSR g;
+    g.n = n;
+    g.start.assign(n + 1, 0);
+    each_edge([&](int from, int) { g.start[from + 1]++; });
+    for (int v = 0; v < n; v++) {
+        g.start[v + 1] += g.start[v];
+    }
+    g.to.resize(g.start[n]);
+    std::vector<int> pos(g.start.begin(), g.start.end() - 1);
+    each_edge([&](int from, int to) { g.to[pos[from]++] = to; });
+    return g;
+}
+
+/// 辺リストから作る
+inline CSR from_edges(int n,
+                      const std::vector<int>& from,
+                      const std::vector<int>& to) {
+    assert(from.size() == to.size());
+    return build(n, [&](auto emit) {
+        for (size_t i = 0; i < from.size(); i++) {
+            emit(from[i], to[i]);
+        }
+    });
+}
+
+/// 重み付き辺リストから作る
+inline CSR from_weighted_edges(int n,
+                               const std::vector<int>& from,
+                               const std::vector<int>& to,
+                               const std::vector<long long>& cost) {
+    assert(from.size() == cost.size());
+    CSR g = from_edges(n, from, to);
+    // build は同じ始点の辺の順序を保つ
+    g.cost.resize(cost.size());
+    std::vector<int> pos(g.start.begin(), g.start.end() - 1);
+    for (size_t i = 0; i < from.size(); i++) {
+        g.cost[pos[from[i]]++] = cost[i];
+    }
+    return g;
+}
+
+/// 無向辺のリストから, 両向きの辺を持つCSRを作る
+inline CSR from_undirected_edges(int n,
+                                 const std::vector<int>& u,
+                                 const std::vector<int>& v) {
+    assert(u.size() == v.size());
+    return build(n, [&](auto emit) {
+        for (size_t i = 0; i < u.size(); i++) {
+            emit(u[i], v[i]);
+            emit(v[i], u[i]);
+        }
+    });
+}
+
+/// E{to} の隣接リストにする (SCCEdge, LCAEdge など)
+template <class E>
+std::vector<std::vector<E>> to_adjacency(const CSR& g) {
+    std::vector<std::vector<E>> res(g.n);
+    for (int v = 0; v < g.n; v++) {
+        res[v].reserve(g.degree(v));
+        for (int i = g.start[v]; i < g.start[v + 1]; i++) {
+            res[v].push_back(E{g.to[i]});
+        }
+    }
+    return res;
+}
+
+/// E{to, cost} の隣接リストにする (DijkstraEdge など)
+template <class E>
+std::vector<std::vector<E>> to_weighted_adjacency(const CSR& g) {
+    assert(g.weighted());
+    std::vector<std::vector<E>> res(g.n);
+    for (int v = 0; v < g.n; v++) {
+        res[v].reserve(g.degree(v));
+        for (int i = g.start[v]; i < g.start[v + 1]; i++) {
+            res[v].push_back(E{g.to[i], g.cost[i]});
+        }
+    }
+    return res;
+}
+
+}  // namespace csr
+
+}  // namespace algotest
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "csr.h"
+
+// "正しい"単一始点最短路 (重みは非負)
+namespace algotest {
+
+namespace dijkstra {
+
+using algotest::csr::CSRView;
+
+constexpr long long INF = std::numeric_limits<long long>::max();
+
+/// s からの最短距離, 到達不可能なら INF
+inline std::vector<long long> dist_from(CSRView g, int s) {
+    assert(g.weighted());
+    using P = std::pair<long long, int>;
+    std::vector<long long> dist(g.n, INF);
+    std::vector<P> buf;
+    buf.reserve(g.n);
+    std::priority_queue<P, std::vector<P>, std::greater<P>> que(
+        std::greater<P>(), std::move(buf));
+    dist[s] = 0;
+    que.emplace(0, s);
+    while (!que.empty()) {
+        P p = que.top();
+        que.pop();
+        int v = p.second;
+        if (dist[v] < p.first)
+            continue;
+        for (int i = g.start[v]; i < g.start[v + 1]; i++) {
+            long long nd = p.first + g.cost[i];
+            if (nd < dist[g.to[i]]) {
+                dist[g.to[i]] = nd;
+                que.emplace(nd, g.to[i]);
+            }
+        }
+    }
+    return dist;
+}
+
+/**
+ * dist が s からの最短距離であることを O(n + m) で確かめる
+ * 1. dist[s] = 0
+ * 2. どの辺 (u, v, c) も dist[v] <= dist[u] + c (距離は下界)
+ * 3. dist[v] = dist[u] + c を満たす辺だけで s から dist < INF の全頂点に行ける
+ *    (距離を実現する経路がある)
+ */
+inline bool verify(CSRView g, int s, const std::vector<long long>& dist) {
+    assert(g.weighted());
+    if (int(dist.size()) != g.n || dist[s] != 0)
+        return false;
+    for (int u = 0; u < g.n; u++) {
+        if (dist[u] == INF)
+            continue;
+        for (int i = g.start[u]; i < g.start[u + 1]; i++) {
+            if (g.cost[i] < 0 || dist[g.to[i]] - g.cost[i] > dist[u])
+                return false;
+        }
+    }
+    std::vector<char> vis(g.n, 0);
+    std::vector<int> st = {s};
+    vis[s] = 1;
+    int reached = 1;
+    while (!st.empty()) {
+        int u = st.back();
+        st.pop_back();
+        for (int i = g.start[u]; i < g.start[u + 1]; i++) {
+            int v = g.to[i];
+            if (!vis[v] && dist[v] - g.cost[i] == dist[u]) {
+                vis[v] = 1;
+                reached++;
+                st.push_back(v);
+            }
+        }
+    }
+    for (int v = 0; v < g.n; v++) {
+        if (dist[v] != INF)
+            reached--;
+    }
+    return reached == 0;
+}
+
+}  // namespace dijkstra
+
+}  // namespace algotest
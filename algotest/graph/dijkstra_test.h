@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include "csr.h"
 
 namespace algotest {
 
@@ -16,10 +17,22 @@ class DijkstraTesterBase {
                                int t) = 0;
 };
 
+/// グラフをコピーせずに受け取る版
+class DijkstraViewTesterBase {
+    /// s, t間の最短距離を返す, 到達不可能ならばnumeric_limit<long long>::max()
+    /// 頂点 v から出る辺は g.to[i], g.cost[i] (g.start[v] <= i < g.start[v + 1])
+    virtual long long min_dist(csr::CSRView g, int s, int t) = 0;
+};
+
 }  // namespace algotest
 
 #include <numeric>
+#include "../complexity.h"
+#include "../perf.h"
 #include "../random.h"
+#include "csr.h"
+#include "dijkstra.h"
+#include "generator.h"
 #include "gtest/gtest.h"
 
 namespace algotest {
@@ -32,33 +45,156 @@ TYPED_TEST_CASE_P(DijkstraTest);
 /// 小さなケースでのランダムテスト
 TYPED_TEST_P(DijkstraTest, StressTest) {
     using G = std::vector<std::vector<DijkstraEdge>>;
-    const long long INF = std::numeric_limits<long long>::max();
     auto gen = algotest::random::Random();
 
     for (int ph = 0; ph < 100; ph++) {
         int n = gen.uniform(2, 20);
         int m = gen.uniform(1, 100);
         G g(n);
-        std::vector<std::vector<long long>> dist(
-            n, std::vector<long long>(n, INF));
-        for (int i = 0; i < n; i++)
-            dist[i][i] = 0;
+        std::vector<int> from(m), to(m);
+        std::vector<long long> cost(m);
         for (int i = 0; i < m; i++) {
-            int a = gen.uniform(0, n - 1);
-            int b = gen.uniform(0, n - 1);
-            long long c = gen.uniform(0, 1000);
-            g[a].push_back(DijkstraEdge{b, c});
-            dist[a][b] = std::min(dist[a][b], c);
+            from[i] = gen.uniform(0, n - 1);
+            to[i] = gen.uniform(0, n - 1);
+            cost[i] = gen.uniform(0, 1000);
+            g[from[i]].push_back(DijkstraEdge{to[i], cost[i]});
+        }
+        int s, t;
+        while (true) {
+            s = gen.uniform(0, n - 1);
+            t = gen.uniform(0, n - 1);
+            if (s == t)
+                continue;
+            break;
+        }
+        csr::CSR h = csr::from_weighted_edges(n, from, to, cost);
+        std::vector<long long> dist = dijkstra::dist_from(h, s);
+        ASSERT_TRUE(dijkstra::verify(h, s, dist)) << "reference dijkstra";
+
+        TypeParam your_dijkstra;
+        ASSERT_EQ(dist[t], your_dijkstra.min_dist(g, s, t));
+    }
+}
+
+/**
+ * n = 10^6, m = 10^7 までの大きなケース
+ * 参照実装の距離をポテンシャル条件で O(n + m) で検証してから比べる
+ */
+TYPED_TEST_P(DijkstraTest, LargeStressTest) {
+    auto gen = algotest::random::Random();
+    // 重みを付けた g の上で, s から q 個の頂点への距離を比べる
+    // 中の ASSERT はラムダを抜けるだけなので, 呼んだ側で失敗を見て止める
+    auto check = [&](const csr::CSR& g, int q, const char* key) {
+        SCOPED_TRACE(key);
+        int s = gen.uniform(0, g.n - 1);
+        std::vector<long long> dist = dijkstra::dist_from(g, s);
+        ASSERT_TRUE(dijkstra::verify(g, s, dist));
+        // 一番遠い頂点と, ランダムな頂点
+        int far = s;
+        for (int v = 0; v < g.n; v++) {
+            if (dist[v] != dijkstra::INF && dist[v] > dist[far])
+                far = v;
+        }
+        std::vector<int> ts = {far};
+        while (int(ts.size()) < q) {
+            int t = gen.uniform(0, g.n - 1);
+            if (t != s)
+                ts.push_back(t);
         }
-        for (int k = 0; k < n; k++) {
-            for (int i = 0; i < n; i++) {
-                for (int j = 0; j < n; j++) {
-                    if (dist[i][k] == INF || dist[k][j] == INF)
-                        continue;
-                    dist[i][j] = std::min(dist[i][j], dist[i][k] + dist[k][j]);
-                }
+        auto adj = csr::to_weighted_adjacency<DijkstraEdge>(g);
+        for (int t : ts) {
+            if (t == s)
+                continue;
+            TypeParam your_dijkstra;
+            long long res;
+            perf::Result pr = perf::measure(
+                [&] { res = your_dijkstra.min_dist(adj, s, t); });
+            ASSERT_EQ(dist[t], res) << "s = " << s << ", t = " << t;
+            if (t == far) {
+                // 辺1本あたりのカウンタを XML 出力に残す (取れなければ何もしない)
+                pr.each([&](const std::string& event, double v) {
+                    ::testing::Test::RecordProperty(
+                        std::string(key) + "_" + event,
+                        std::to_string(v / double(g.edge_count())));
+                });
             }
         }
+    };
+
+    for (int ph = 0; ph < 10; ph++) {
+        csr::CSR g = generator::random_graph(1000, 10000, gen);
+        generator::assign_costs(g, 0, 1000000000, gen);
+        check(g, 4, "random_1e3_1e4");
+        if (this->HasFatalFailure())
+            return;
+    }
+    {
+        csr::CSR g = generator::random_graph(100000, 1000000, gen);
+        generator::assign_costs(g, 0, 1000000000, gen);
+        check(g, 3, "random_1e5_1e6");
+        if (this->HasFatalFailure())
+            return;
+    }
+    {
+        // 疎で, 到達できない頂点が多い
+        csr::CSR g = generator::random_graph(1000000, 1000000, gen);
+        generator::assign_costs(g, 0, 1000000000, gen);
+        check(g, 3, "random_1e6_1e6");
+        if (this->HasFatalFailure())
+            return;
+    }
+    {
+        // 格子は最短路が長く, ヒープに同じ頂点が何度も入る
+        csr::CSR g = generator::grid(1000, 1000);
+        generator::assign_costs(g, 1, 1000000000, gen);
+        check(g, 2, "grid_1000x1000");
+        if (this->HasFatalFailure())
+            return;
+    }
+    {
+        csr::CSR g = generator::rmat(20, 8000000, gen);
+        generator::assign_costs(g, 0, 1000000, gen);
+        check(g, 2, "rmat_2p20_8e6");
+        if (this->HasFatalFailure())
+            return;
+    }
+    {
+        // 重みが小さく同じ距離が大量にある
+        csr::CSR g = generator::random_graph(1000000, 10000000, gen);
+        generator::assign_costs(g, 0, 3, gen);
+        check(g, 1, "random_1e6_1e7_small_cost");
+        if (this->HasFatalFailure())
+            return;
+    }
+    {
+        csr::CSR g = generator::random_graph(1000000, 10000000, gen);
+        generator::assign_costs(g, 0, 1000000000000LL, gen);
+        check(g, 1, "random_1e6_1e7");
+    }
+}
+
+// おまじない
+REGISTER_TYPED_TEST_CASE_P(DijkstraTest, StressTest, LargeStressTest);
+
+template <typename DIJKSTRA>
+class DijkstraViewTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(DijkstraViewTest);
+
+/// 小さなケースでのランダムテスト (DijkstraTest::StressTest と同じケース)
+TYPED_TEST_P(DijkstraViewTest, StressTest) {
+    auto gen = algotest::random::Random();
+
+    for (int ph = 0; ph < 100; ph++) {
+        int n = gen.uniform(2, 20);
+        int m = gen.uniform(1, 100);
+        std::vector<int> from(m), to(m);
+        std::vector<long long> cost(m);
+        for (int i = 0; i < m; i++) {
+            from[i] = gen.uniform(0, n - 1);
+            to[i] = gen.uniform(0, n - 1);
+            cost[i] = gen.uniform(0, 1000);
+        }
         int s, t;
         while (true) {
             s = gen.uniform(0, n - 1);
@@ -67,13 +203,71 @@ TYPED_TEST_P(DijkstraTest, StressTest) {
                 continue;
             break;
         }
+        csr::CSR g = csr::from_weighted_edges(n, from, to, cost);
+        std::vector<long long> dist = dijkstra::dist_from(g, s);
+        ASSERT_TRUE(dijkstra::verify(g, s, dist)) << "reference dijkstra";
 
         TypeParam your_dijkstra;
-        ASSERT_EQ(dist[s][t], your_dijkstra.min_dist(g, s, t));
+        ASSERT_EQ(dist[t], your_dijkstra.min_dist(g, s, t));
     }
 }
 
-// おまじない
-REGISTER_TYPED_TEST_CASE_P(DijkstraTest, StressTest);
+/// n = 10^6, m = 10^7 のケース, グラフは1つの CSR を共有する
+TYPED_TEST_P(DijkstraViewTest, LargeStressTest) {
+    auto gen = algotest::random::Random();
+    std::vector<csr::CSR> graphs;
+    graphs.push_back(generator::grid(1000, 1000));
+    generator::assign_costs(graphs.back(), 1, 1000000000, gen);
+    graphs.push_back(generator::random_graph(1000000, 10000000, gen));
+    generator::assign_costs(graphs.back(), 0, 1000000000000LL, gen);
+    for (const csr::CSR& g : graphs) {
+        int s = gen.uniform(0, g.n - 1);
+        std::vector<long long> dist = dijkstra::dist_from(g, s);
+        ASSERT_TRUE(dijkstra::verify(g, s, dist));
+        for (int ph = 0; ph < 3; ph++) {
+            int t = gen.uniform(0, g.n - 1);
+            if (t == s)
+                continue;
+            TypeParam your_dijkstra;
+            ASSERT_EQ(dist[t], your_dijkstra.min_dist(g, s, t))
+                << "s = " << s << ", t = " << t;
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(DijkstraViewTest, StressTest, LargeStressTest);
+
+template <typename DIJKSTRA>
+class DijkstraComplexityTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(DijkstraComplexityTest);
+
+/// m = 2^10 ~ 2^22 (n = m / 4) で実行時間を測り, O(m log n) から外れていないか見る
+TYPED_TEST_P(DijkstraComplexityTest, MinDistTest) {
+    using G = std::vector<std::vector<DijkstraEdge>>;
+    auto gen = algotest::random::Random();
+    std::vector<complexity::Sample> samples;
+
+    for (int lg = 10; lg <= 22; lg += 2) {
+        int m = 1 << lg;
+        int n = m / 4;
+        G g(n);
+        for (int i = 0; i < m; i++) {
+            int a = gen.uniform(0, n - 1);
+            int b = gen.uniform(0, n - 1);
+            long long c = gen.uniform(0, 1000000000);
+            g[a].push_back(DijkstraEdge{b, c});
+        }
+        double sec = complexity::measure([&] {
+            TypeParam your_dijkstra;
+            complexity::keep(your_dijkstra.min_dist(g, 0, n - 1));
+        });
+        samples.push_back(complexity::Sample{double(m), sec});
+    }
+    double excess = complexity::excess_exponent(samples, complexity::n_log_n);
+    ASSERT_LE(excess, complexity::kMaxExcess) << complexity::dump(samples);
+}
+
+REGISTER_TYPED_TEST_CASE_P(DijkstraComplexityTest, MinDistTest);
 
 }  // namespace algotest
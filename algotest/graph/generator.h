@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "../random.h"
+#include "csr.h"
+
+// 大きなグラフ・木の生成器, 結果は直接CSRに書き込む
+namespace algotest {
+
+namespace generator {
+
+using algotest::csr::CSR;
+using algotest::random::Random;
+
+/**
+ * edge(gen) で作った辺を m 本並べたグラフ
+ * gen を巻き戻して2回なぞるので, 辺リストを持たずにCSRを作れる
+ */
+template <class F>
+CSR random_edges(int n, long long m, Random& gen, F edge) {
+    Random init = gen;
+    return csr::build(n, [&](auto emit) {
+        gen = init;
+        for (long long i = 0; i < m; i++) {
+            std::pair<int, int> e = edge(gen);
+            emit(e.first, e.second);
+        }
+    });
+}
+
+/// 頂点数 n, 辺数 m, 端点が一様ランダムな有向グラフ (多重辺, 自己ループあり)
+inline CSR random_graph(int n, long long m, Random& gen) {
+    return random_edges(n, m, gen, [&](Random& r) {
+        return std::make_pair(r.uniform(0, n - 1), r.uniform(0, n - 1));
+    });
+}
+
+/// 頂点数 n (>= 2), 辺数 m のDAG, 頂点番号はトポロジカル順とは限らない
+inline CSR dag(int n, long long m, Random& gen) {
+    assert(n >= 2);
+    std::vector<int> ord = gen.perm(n);
+    return random_edges(n, m, gen, [&](Random& r) {
+        int a = r.uniform(0, n - 1);
+        int b = r.uniform(0, n - 2);
+        if (b >= a)
+            b++;
+        if (a > b)
+            std::swap(a, b);
+        return std::make_pair(ord[a], ord[b]);
+    });
+}
+
+/// h x w の格子グラフ, 頂点 (i, j) は i * w + j, 隣接4方向に両向きの辺
+inline CSR grid(int h, int w) {
+    return csr::build(h * w, [&](auto emit) {
+        for (int i = 0; i < h; i++) {
+            for (int j = 0; j < w; j++) {
+                int v = i * w + j;
+                if (i > 0)
+                    emit(v, v - w);
+                if (i + 1 < h)
+                    emit(v, v + w);
+                if (j > 0)
+                    emit(v, v - 1);
+                if (j + 1 < w)
+                    emit(v, v + 1);
+            }
+        }
+    });
+}
+
+/**
+ * R-MAT グラフ, 頂点数 2^scale, 辺数 m
+ * 隣接行列を4分割して確率 a, b, c, 1-a-b-c で降りていく, 次数がべき乗則に従う
+ * 確率は 1/2^16 単位に丸める, 頂点番号はランダムに振り直す
+ */
+inline CSR rmat(int scale,
+                long long m,
+                Random& gen,
+                double a = 0.57,
+                double b = 0.19,
+                double c = 0.19) {
+    int n = 1 << scale;
+    const uint64_t ta = uint64_t(a * 65536), tb = uint64_t((a + b) * 65536),
+                   tc = uint64_t((a + b + c) * 65536);
+    std::vector<int> id = gen.perm(n);
+    return random_edges(n, m, gen, [&](Random& r) {
+        int from = 0, to = 0;
+        uint64_t bits = 0;
+        for (int i = 0; i < scale; i++) {
+            // 1回の乱数で4段ぶん
+            if (i % 4 == 0)
+                bits = r.uniform(uint64_t(0), ~uint64_t(0));
+            uint64_t p = bits & 0xffff;
+            bits >>= 16;
+            // [0, ta): 左上, [ta, tb): 右上, [tb, tc): 左下, [tc, 2^16): 右下
+            from = (from << 1) | int(p >= tb);
+            to = (to << 1) | int((ta <= p && p < tb) || tc <= p);
+        }
+        return std::make_pair(id[from], id[to]);
+    });
+}
+
+/// 辺 (i, par[i]) (i >= 1) を持つ木を, 頂点番号を id で振り直して両向きのCSRにする
+inline CSR tree_from_parent(const std::vector<int>& par,
+                            const std::vector<int>& id) {
+    int n = int(par.size());
+    return csr::build(n, [&](auto emit) {
+        for (int i = 1; i < n; i++) {
+            emit(id[i], id[par[i]]);
+            emit(id[par[i]], id[i]);
+        }
+    });
+}
+
+/// 一様ランダムなラベル付き木 (Prufer列を線形時間で復元する)
+inline CSR random_tree(int n, Random& gen) {
+    if (n <= 2) {
+        std::vector<int> par(n, 0);
+        std::vector<int> id(n);
+        std::iota(id.begin(), id.end(), 0);
+        return tree_from_parent(par, id);
+    }
+    std::vector<int> code = gen.uniform_vector(n - 2, 0, n - 1);
+    std::vector<int> deg(n, 1);
+    for (int v : code) {
+        deg[v]++;
+    }
+    std::vector<int> u, v;
+    u.reserve(n - 1);
+    v.reserve(n - 1);
+    int ptr = 0;
+    while (deg[ptr] != 1)
+        ptr++;
+    int leaf = ptr;
+    for (int x : code) {
+        u.push_back(leaf);
+        v.push_back(x);
+        if (--deg[x] == 1 && x < ptr) {
+            leaf = x;
+        } else {
+            ptr++;
+            while (deg[ptr] != 1)
+                ptr++;
+            leaf = ptr;
+        }
+    }
+    u.push_back(leaf);
+    v.push_back(n - 1);
+    return csr::from_undirected_edges(n, u, v);
+}
+
+/// 頂点 i の親を [i - width, i) から選んだ細長い木, width = 1 ならパス
+inline CSR path_like_tree(int n, int width, Random& gen) {
+    std::vector<int> par(n, 0);
+    for (int i = 1; i < n; i++) {
+        par[i] = gen.uniform(std::max(0, i - width), i - 1);
+    }
+    return tree_from_parent(par, gen.perm(n));
+}
+
+/// 星
+inline CSR star_tree(int n, Random& gen) {
+    return tree_from_parent(std::vector<int>(n, 0), gen.perm(n));
+}
+
+/// 長さ spine のパスに, 残りの頂点を葉としてぶら下げた木 (毛虫)
+inline CSR caterpillar_tree(int n, int spine, Random& gen) {
+    assert(1 <= spine && spine <= n);
+    std::vector<int> par(n, 0);
+    for (int i = 1; i < spine; i++) {
+        par[i] = i - 1;
+    }
+    for (int i = spine; i < n; i++) {
+        par[i] = gen.uniform(0, spine - 1);
+    }
+    return tree_from_parent(par, gen.perm(n));
+}
+
+/// 全ての辺に [lower, upper] の重みを付ける
+inline void assign_costs(CSR& g,
+                         long long lower,
+                         long long upper,
+                         Random& gen) {
+    g.cost = gen.uniform_vector(size_t(g.edge_count()), lower, upper);
+}
+
+}  // namespace generator
+
+}  // namespace algotest
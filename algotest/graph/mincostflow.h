@@ -1,6 +1,11 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace algotest {
@@ -128,5 +133,245 @@ MinCostFlow<C, D, E> get_mcf(const VV<E>& g, int s, int t, bool neg = false) {
     return MinCostFlow<C, D, E>(g, s, t, neg);
 }
 
+/// 単調なキー(Dijkstra の距離)専用の優先度付きキュー
+template <class T>
+struct RadixHeap {
+    using U = make_unsigned_t<T>;
+    V<pair<U, int>> bucket[sizeof(U) * 8 + 1];
+    U last = 0;
+    size_t sz = 0;
+
+    static int bsr(U x) {
+        return x ? int(sizeof(unsigned long long) * 8) - 1 -
+                       __builtin_clzll((unsigned long long)(x))
+                 : -1;
+    }
+
+    bool empty() const { return sz == 0; }
+
+    void push(T key, int v) {
+        assert(last <= U(key));
+        sz++;
+        bucket[bsr(U(key) ^ last) + 1].emplace_back(U(key), v);
+    }
+
+    /// 最小のキーを持つ要素を取り出す
+    pair<T, int> pop() {
+        if (bucket[0].empty()) {
+            int i = 1;
+            while (bucket[i].empty())
+                i++;
+            last = numeric_limits<U>::max();
+            for (auto& p : bucket[i])
+                last = min(last, p.first);
+            for (auto& p : bucket[i])
+                bucket[bsr(p.first ^ last) + 1].push_back(p);
+            bucket[i].clear();
+        }
+        auto p = bucket[0].back();
+        bucket[0].pop_back();
+        sz--;
+        return {T(p.first), p.second};
+    }
+};
+
+/**
+ * 大きなグラフ用の最小費用流 (整数コスト)
+ * 残余グラフはCSRで持ち, 最短路は radix heap 上の Dijkstra
+ * 負辺があればポテンシャルを, DAG ならトポロジカル順のDPで, そうでなければ SPFA で求める
+ */
+template <class C, class D>
+struct FastMinCostFlow {
+    static constexpr D INF = numeric_limits<D>::max();
+    int n, s, t;
+    C nc = 0, cap_flow = 0;
+    D nd = 0, flow = 0;
+
+    /// 残余グラフ, 頂点 v の辺は [start[v], start[v + 1])
+    V<int> start, to, rev;
+    V<C> cap;
+    V<D> cost;
+
+    V<D> dual;
+    V<int> pe;
+
+    /// es[i] = {from, to, cap, cost}
+    struct InEdge {
+        int from, to;
+        C cap;
+        D cost;
+    };
+
+    FastMinCostFlow(int _n, const V<InEdge>& es, int _s, int _t)
+        : n(_n), s(_s), t(_t) {
+        assert(s != t);
+        int m = int(es.size());
+        start = V<int>(n + 1);
+        for (auto& e : es) {
+            start[e.from + 1]++;
+            start[e.to + 1]++;
+        }
+        for (int v = 0; v < n; v++) {
+            start[v + 1] += start[v];
+        }
+        to = rev = V<int>(2 * m);
+        cap = V<C>(2 * m);
+        cost = V<D>(2 * m);
+        V<int> pos(start.begin(), start.end() - 1);
+        bool neg = false;
+        for (auto& e : es) {
+            int i = pos[e.from]++, j = pos[e.to]++;
+            to[i] = e.to;
+            cap[i] = e.cap;
+            cost[i] = e.cost;
+            rev[i] = j;
+            to[j] = e.from;
+            cap[j] = 0;
+            cost[j] = -e.cost;
+            rev[j] = i;
+            if (e.cap && e.cost < 0)
+                neg = true;
+        }
+        dual = V<D>(n);
+        pe = V<int>(n, -1);
+        if (neg && !init_dual_dag())
+            init_dual_spfa();
+        dual_ref();
+    }
+
+    /// 容量正の辺がDAGならトポロジカル順で s からの最短路を求める
+    bool init_dual_dag() {
+        V<int> indeg(n), ord;
+        ord.reserve(n);
+        for (int i = 0; i < int(to.size()); i++) {
+            if (cap[i])
+                indeg[to[i]]++;
+        }
+        for (int v = 0; v < n; v++) {
+            if (!indeg[v])
+                ord.push_back(v);
+        }
+        for (int h = 0; h < int(ord.size()); h++) {
+            int v = ord[h];
+            for (int i = start[v]; i < start[v + 1]; i++) {
+                if (cap[i] && --indeg[to[i]] == 0)
+                    ord.push_back(to[i]);
+            }
+        }
+        if (int(ord.size()) != n)
+            return false;
+        V<D> dist(n, D(INF));
+        dist[s] = 0;
+        for (int v : ord) {
+            if (dist[v] == INF)
+                continue;
+            for (int i = start[v]; i < start[v + 1]; i++) {
+                if (cap[i])
+                    dist[to[i]] = min(dist[to[i]], dist[v] + cost[i]);
+            }
+        }
+        for (int v = 0; v < n; v++) {
+            dual[v] = (dist[v] == INF) ? 0 : dist[v];
+        }
+        return true;
+    }
+
+    /// キューを使った Bellman-Ford (負閉路はないとする)
+    void init_dual_spfa() {
+        V<D> dist(n, D(INF));
+        V<char> inq(n);
+        V<int> que;
+        dist[s] = 0;
+        que.push_back(s);
+        inq[s] = true;
+        for (size_t h = 0; h < que.size(); h++) {
+            int v = que[h];
+            inq[v] = false;
+            for (int i = start[v]; i < start[v + 1]; i++) {
+                if (!cap[i] || dist[to[i]] <= dist[v] + cost[i])
+                    continue;
+                dist[to[i]] = dist[v] + cost[i];
+                if (!inq[to[i]]) {
+                    inq[to[i]] = true;
+                    que.push_back(to[i]);
+                }
+            }
+        }
+        for (int v = 0; v < n; v++) {
+            dual[v] = (dist[v] == INF) ? 0 : dist[v];
+        }
+    }
+
+    C single_flow(C c) {
+        if (nd == INF)
+            return nc;
+        c = min(c, nc);
+        for (int v = t; v != s; v = to[rev[pe[v]]]) {
+            cap[pe[v]] -= c;
+            cap[rev[pe[v]]] += c;
+        }
+        cap_flow += c;
+        flow += nd * c;
+        nc -= c;
+        if (!nc)
+            dual_ref();
+        return c;
+    }
+
+    void max_flow(C c) {
+        while (c) {
+            C f = single_flow(c);
+            if (!f)
+                break;
+            c -= f;
+        }
+    }
+
+    void dual_ref() {
+        V<D> dist(n, D(INF));
+        V<char> vis(n);
+        fill(pe.begin(), pe.end(), -1);
+        RadixHeap<D> que;
+        dist[s] = 0;
+        que.push(D(0), s);
+        V<int> visited;
+        while (!que.empty()) {
+            auto p = que.pop();
+            int v = p.second;
+            if (vis[v] || dist[v] != p.first)
+                continue;
+            vis[v] = true;
+            visited.push_back(v);
+            if (v == t)
+                break;
+            for (int i = start[v]; i < start[v + 1]; i++) {
+                int u = to[i];
+                if (vis[u] || !cap[i])
+                    continue;
+                D c = dist[v] + cost[i] + dual[v] - dual[u];
+                if (dist[u] > c) {
+                    dist[u] = c;
+                    pe[u] = i;
+                    que.push(c, u);
+                }
+            }
+        }
+        if (dist[t] == INF) {
+            nd = INF;
+            nc = 0;
+            return;
+        }
+        for (int v : visited) {
+            dual[v] += dist[v] - dist[t];
+        }
+        // 負辺があれば負になりうる
+        nd = dual[t] - dual[s];
+        nc = numeric_limits<C>::max();
+        for (int v = t; v != s; v = to[rev[pe[v]]]) {
+            nc = min(nc, cap[pe[v]]);
+        }
+    }
+};
+
 }  // namespace mincostflow
 }  // namespace algotest
\ No newline at end of file
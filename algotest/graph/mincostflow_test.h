@@ -43,35 +43,25 @@ using VV = V<V<T>>;
 class MCFCorrect : MinCostFlowTesterBase {
   public:
     ll max_flow_min_cost(VV<MinCostFlowEdge> _g, int s, int t) final {
+        using MCF = FastMinCostFlow<int, ll>;
         int n = int(_g.size());
-        struct E {
-            int to, cap;
-            ll dist;
-            int rev;
-        };
-        VV<E> g(n);
-        VV<E> elist(n);
-        auto add_edge = [&](int from, int to, int cap, ll dist) {
-            elist[from].push_back(E{to, cap, dist, -1});
-            g[from].push_back(E{to, cap, dist, int(g[to].size())});
-            g[to].push_back(E{from, 0, -dist, int(g[from].size()) - 1});
-        };
+        V<MCF::InEdge> es;
         for (int i = 0; i < n; i++) {
             for (auto e : _g[i]) {
-                add_edge(i, e.to, e.cap, e.cost);
+                es.push_back(MCF::InEdge{i, e.to, e.cap, e.cost});
             }
         }
 
-        auto res = get_mcf<int, ll>(g, s, t, false);
+        MCF res(n, es, s, t);
         res.max_flow(1000000000);
 
+        // 双対問題の値と一致するか確かめる
         ll sm = (res.dual[t] - res.dual[s]) * res.cap_flow;
-        for (int i = 0; i < n; i++) {
-            for (auto e : elist[i]) {
-                if (!e.cap || res.dual[i] == decltype(res)::INF)
-                    continue;
-                sm -= max(0LL, (res.dual[e.to] - res.dual[i]) - e.dist) * e.cap;
-            }
+        for (auto e : es) {
+            if (!e.cap)
+                continue;
+            sm -= max(0LL, (res.dual[e.to] - res.dual[e.from]) - e.cost) *
+                  e.cap;
         }
         assert(res.flow == sm);
         return sm;
@@ -169,10 +159,79 @@ TYPED_TEST_P(MinCostFlowTest, StressTest) {
     }
 }
 
+/// 10^4 頂点 5 * 10^4 辺のランダムグラフ, 左右 2000 頂点ずつの割当問題,
+/// 300 x 300 の格子
+TYPED_TEST_P(MinCostFlowTest, LargeStressTest) {
+    algotest::random::Random gen;
+    using G = std::vector<std::vector<MinCostFlowEdge>>;
+    std::vector<std::pair<G, std::pair<int, int>>> cases;
+
+    {
+        int n = 10000, m = 50000;
+        G g(n);
+        for (int i = 0; i < m; i++) {
+            int x = gen.uniform(0, n - 1);
+            int y = gen.uniform(0, n - 2);
+            if (y >= x)
+                y++;
+            int cap = gen.uniform(1, 100);
+            long long cost = gen.uniform(0, 100);
+            g[x].push_back(MinCostFlowEdge{y, cap, cost});
+        }
+        cases.push_back({g, {0, n - 1}});
+    }
+    {
+        int k = 2000, deg = 10;
+        int s = 2 * k, t = 2 * k + 1;
+        G g(2 * k + 2);
+        for (int i = 0; i < k; i++) {
+            g[s].push_back(MinCostFlowEdge{i, 1, 0});
+            g[k + i].push_back(MinCostFlowEdge{t, 1, 0});
+            for (int j = 0; j < deg; j++) {
+                int y = k + gen.uniform(0, k - 1);
+                long long cost = gen.uniform(0, 1000000);
+                g[i].push_back(MinCostFlowEdge{y, 1, cost});
+            }
+        }
+        cases.push_back({g, {s, t}});
+    }
+    {
+        int h = 300, w = 300;
+        G g(h * w);
+        for (int i = 0; i < h; i++) {
+            for (int j = 0; j < w; j++) {
+                int v = i * w + j;
+                if (i + 1 < h)
+                    g[v].push_back(MinCostFlowEdge{v + w, gen.uniform(1, 100),
+                                                   gen.uniform(0LL, 100LL)});
+                if (j + 1 < w)
+                    g[v].push_back(MinCostFlowEdge{v + 1, gen.uniform(1, 100),
+                                                   gen.uniform(0LL, 100LL)});
+                if (i > 0)
+                    g[v].push_back(MinCostFlowEdge{v - w, gen.uniform(1, 100),
+                                                   gen.uniform(0LL, 100LL)});
+                if (j > 0)
+                    g[v].push_back(MinCostFlowEdge{v - 1, gen.uniform(1, 100),
+                                                   gen.uniform(0LL, 100LL)});
+            }
+        }
+        cases.push_back({g, {0, h * w - 1}});
+    }
+
+    for (auto& c : cases) {
+        int s = c.second.first, t = c.second.second;
+        TypeParam your_mcf;
+        mincostflow::MCFCorrect ans_mcf;
+        ASSERT_EQ(ans_mcf.max_flow_min_cost(c.first, s, t),
+                  your_mcf.max_flow_min_cost(c.first, s, t));
+    }
+}
+
 // おまじない
 REGISTER_TYPED_TEST_CASE_P(MinCostFlowTest,
                            IssueNegative,
                            StressTestSmall,
-                           StressTest);
+                           StressTest,
+                           LargeStressTest);
 
 }  // namespace algotest
@@ -13,9 +13,25 @@ class UnionFindTesterBase {
     virtual bool is_connect(int u, int v) = 0;
 };
 
+/// 複数スレッドから同時に呼ばれる版
+class ConcurrentUnionFindTesterBase {
+    /// 最初に一度, 1つのスレッドから呼ばれる。nは頂点数
+    virtual void setup(int n) = 0;
+    /// u, vを連結する, 他のスレッドの add, is_connect と同時に呼ばれる
+    virtual void add(int u, int v) = 0;
+    /// u, vが連結か返す, 他のスレッドの add, is_connect と同時に呼ばれる
+    virtual bool is_connect(int u, int v) = 0;
+};
+
 }  // namespace algotest
 
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <set>
+#include <thread>
 #include "../random.h"
+#include "../shard.h"
 #include "gtest/gtest.h"
 
 namespace algotest {
@@ -78,4 +94,284 @@ TYPED_TEST_P(UnionFindTest, StressTest) {
 // おまじない
 REGISTER_TYPED_TEST_CASE_P(UnionFindTest, StressTest);
 
+template <typename UF>
+class ConcurrentUnionFindTest : public ::testing::Test {};
+
+namespace unionfind {
+
+/// 並行実行での1回の呼び出し, s, e は呼び出し前後に取った時刻 (全体で一意)
+struct TimedOp {
+    bool is_add;
+    int u, v;
+    bool res;
+    uint64_t s, e;
+};
+
+/**
+ * ops が線形化可能であるための必要条件を確かめ, 最初に矛盾した is_connect の番号を
+ * 返す (なければ -1)。十分条件ではないので, 小さなケースでは find_linearization で
+ * 実際の線形化を探すこと
+ * 連結性は add で単調に増えるので, [s, e] の間に線形化される is_connect は
+ *   - e より前に始まった add だけで連結でなければ false を返すはず
+ *   - s より前に終わった add と, s より前に終わって true を返した is_connect
+ *     だけで連結なら true を返すはず
+ * 時刻順に2つの UnionFind (開始した add / 終了した add と true の is_connect) を
+ * 更新しながら確かめる
+ */
+inline long long check_linearizable(int n, const std::vector<TimedOp>& ops) {
+    std::vector<long long> at(2 * ops.size(), -1);
+    for (size_t i = 0; i < ops.size(); i++) {
+        assert(ops[i].s < at.size() && ops[i].e < at.size());
+        at[ops[i].s] = 2 * i;
+        at[ops[i].e] = 2 * i + 1;
+    }
+    UnionFind started(n), ended(n);
+    std::vector<char> lower(ops.size());
+    for (long long x : at) {
+        const TimedOp& op = ops[x / 2];
+        bool is_start = x % 2 == 0;
+        if (op.is_add) {
+            (is_start ? started : ended).merge(op.u, op.v);
+        } else if (is_start) {
+            lower[x / 2] = ended.same(op.u, op.v);
+        } else {
+            bool upper = started.same(op.u, op.v);
+            if ((lower[x / 2] && !op.res) || (!upper && op.res))
+                return x / 2;
+            // 以降に始まる呼び出しからは u, v は連結に見えるはず
+            if (op.res)
+                ended.merge(op.u, op.v);
+        }
+    }
+    return -1;
+}
+
+namespace internal {
+
+/// pos[t] は各スレッドで線形化済みの呼び出しの数, uf はその時点の状態
+inline bool linearize(int q,
+                      const std::vector<TimedOp>& ops,
+                      std::vector<int> pos,
+                      UnionFind uf,
+                      std::set<std::vector<int>>& seen,
+                      std::vector<int>& order) {
+    int threads = int(pos.size());
+    size_t depth = order.size();
+    // 状態を変えない呼び出し (結果が合う is_connect, 既に連結な add) は
+    // 置ける時点で置いてよい。false の is_connect が既に連結ならもう置けない
+    while (true) {
+        uint64_t min_e = std::numeric_limits<uint64_t>::max();
+        for (int t = 0; t < threads; t++) {
+            if (pos[t] < q)
+                min_e = std::min(min_e, ops[t * q + pos[t]].e);
+        }
+        if (min_e == std::numeric_limits<uint64_t>::max()) return true;
+        bool moved = false;
+        for (int t = 0; t < threads; t++) {
+            if (pos[t] == q) continue;
+            const TimedOp& op = ops[t * q + pos[t]];
+            // まだ終わっていない他の呼び出しより前に置けるのは, それらが
+            // 終わる前に始まったものだけ
+            if (op.s > min_e) continue;
+            bool same = uf.same(op.u, op.v);
+            if (!op.is_add && !op.res && same) {
+                order.resize(depth);
+                return false;
+            }
+            if (op.is_add ? same : op.res == same) {
+                order.push_back(t * q + pos[t]);
+                pos[t]++;
+                moved = true;
+            }
+        }
+        if (!moved) break;
+    }
+    // 状態は線形化済みの add の集合, つまり pos だけで決まる
+    if (!seen.insert(pos).second) {
+        order.resize(depth);
+        return false;
+    }
+    size_t closed = order.size();
+    uint64_t min_e = std::numeric_limits<uint64_t>::max();
+    for (int t = 0; t < threads; t++) {
+        if (pos[t] < q)
+            min_e = std::min(min_e, ops[t * q + pos[t]].e);
+    }
+    // 残りは連結成分を併合する add で, どれを先に置くかで分岐する
+    for (int t = 0; t < threads; t++) {
+        if (pos[t] == q) continue;
+        const TimedOp& op = ops[t * q + pos[t]];
+        if (!op.is_add || op.s > min_e) continue;
+        std::vector<int> next_pos = pos;
+        next_pos[t]++;
+        UnionFind next_uf = uf;
+        next_uf.merge(op.u, op.v);
+        order.push_back(t * q + pos[t]);
+        if (linearize(q, ops, next_pos, next_uf, seen, order)) return true;
+        order.resize(closed);
+    }
+    order.resize(depth);
+    return false;
+}
+
+}  // namespace internal
+
+/**
+ * run_concurrent が返した ops の線形化を Wing-Gong 流のバックトラックで探し,
+ * 見つかればその順番 (ops の添字) を, なければ空を返す
+ * 分岐するのは併合する add だけなので, 深さは n - 1 以下
+ */
+inline std::vector<int> find_linearization(int n,
+                                           int threads,
+                                           const std::vector<TimedOp>& ops) {
+    assert(ops.size() % threads == 0);
+    int q = int(ops.size() / threads);
+    std::set<std::vector<int>> seen;
+    std::vector<int> order;
+    if (!internal::linearize(q, ops, std::vector<int>(threads, 0),
+                             UnionFind(n), seen, order))
+        return {};
+    return order;
+}
+
+/**
+ * threads 個のスレッドから, それぞれ q 回 add / is_connect を呼ぶ (add の割合は
+ * add_percent %), 全ての呼び出しを時刻付きで返す
+ */
+template <class UF>
+std::vector<TimedOp> run_concurrent(UF& uf,
+                                    int n,
+                                    int threads,
+                                    int q,
+                                    int add_percent,
+                                    random::Random& gen) {
+    std::vector<std::vector<TimedOp>> logs(threads);
+    for (auto& log : logs) {
+        log.resize(q);
+        for (auto& op : log) {
+            op.is_add = gen.uniform(0, 99) < add_percent;
+            op.u = gen.uniform(0, n - 1);
+            op.v = gen.uniform(0, n - 1);
+        }
+    }
+    std::atomic<uint64_t> clock(0);
+    std::atomic<int> ready(0);
+    std::vector<std::thread> ths;
+    for (int t = 0; t < threads; t++) {
+        ths.emplace_back([&, t] {
+            // 全スレッドが揃ってから始める
+            ready++;
+            while (ready < threads)
+                std::this_thread::yield();
+            for (auto& op : logs[t]) {
+                op.s = clock++;
+                if (op.is_add) {
+                    uf.add(op.u, op.v);
+                } else {
+                    op.res = uf.is_connect(op.u, op.v);
+                }
+                op.e = clock++;
+            }
+        });
+    }
+    for (auto& th : ths) {
+        th.join();
+    }
+    std::vector<TimedOp> ops;
+    ops.reserve(size_t(threads) * q);
+    for (auto& log : logs) {
+        ops.insert(ops.end(), log.begin(), log.end());
+        std::vector<TimedOp>().swap(log);
+    }
+    return ops;
+}
+
+}  // namespace unionfind
+
+TYPED_TEST_CASE_P(ConcurrentUnionFindTest);
+
+/**
+ * 並行に add / is_connect を呼び, 最終状態を比べる
+ * n <= 20 の前半は実際に線形化を見つけて逐次 UnionFind で再生し, 後半は
+ * 必要条件だけ確かめる
+ */
+TYPED_TEST_P(ConcurrentUnionFindTest, StressTest) {
+    auto gen = algotest::random::Random();
+    int threads = std::max(4, std::min(16, shard::thread_count()));
+    for (int ph = 0; ph < 100; ph++) {
+        // 小さな n で競合を増やす
+        int n = gen.uniform(2, ph < 50 ? 20 : 1000);
+        int q = gen.uniform(1, 2000);
+        int add_percent = gen.uniform(5, 60);
+        TypeParam your_uf;
+        your_uf.setup(n);
+        auto ops = unionfind::run_concurrent(your_uf, n, threads, q,
+                                             add_percent, gen);
+        long long bad = unionfind::check_linearizable(n, ops);
+        ASSERT_EQ(-1, bad) << "n = " << n << ", is_connect(" << ops[bad].u
+                           << ", " << ops[bad].v << ") = " << ops[bad].res;
+
+        if (ph < 50) {
+            auto order = unionfind::find_linearization(n, threads, ops);
+            ASSERT_EQ(ops.size(), order.size())
+                << "no linearization, n = " << n << ", q = " << q;
+            // 見つけた順番が時刻と矛盾せず, 逐次実行で同じ結果になるか
+            std::vector<char> used(ops.size());
+            uint64_t max_s = 0;
+            unionfind::UnionFind uf(n);
+            for (int i : order) {
+                const auto& op = ops[i];
+                ASSERT_FALSE(used[i]);
+                used[i] = true;
+                ASSERT_LT(max_s, op.e);
+                max_s = std::max(max_s, op.s);
+                if (op.is_add) {
+                    uf.merge(op.u, op.v);
+                } else {
+                    ASSERT_EQ(uf.same(op.u, op.v), op.res);
+                }
+            }
+        }
+
+        unionfind::UnionFind uf(n);
+        for (auto& op : ops) {
+            if (op.is_add)
+                uf.merge(op.u, op.v);
+        }
+        for (int i = 0; i < 100; i++) {
+            int a = gen.uniform(0, n - 1);
+            int b = gen.uniform(0, n - 1);
+            ASSERT_EQ(uf.same(a, b), your_uf.is_connect(a, b));
+        }
+    }
+}
+
+/// n = 10^6, スレッドあたり 2 * 10^5 回 (16 スレッドで 200MB 程度)
+TYPED_TEST_P(ConcurrentUnionFindTest, LargeStressTest) {
+    auto gen = algotest::random::Random();
+    int threads = std::max(4, std::min(16, shard::thread_count()));
+    int n = 1000000, q = 200000;
+    TypeParam your_uf;
+    your_uf.setup(n);
+    auto ops = unionfind::run_concurrent(your_uf, n, threads, q, 50, gen);
+    // 線形化を探すには大きすぎるので, 必要条件だけ確かめる
+    long long bad = unionfind::check_linearizable(n, ops);
+    ASSERT_EQ(-1, bad) << "is_connect(" << ops[bad].u << ", " << ops[bad].v
+                       << ") = " << ops[bad].res;
+
+    unionfind::UnionFind uf(n);
+    for (auto& op : ops) {
+        if (op.is_add)
+            uf.merge(op.u, op.v);
+    }
+    for (int i = 0; i < n; i++) {
+        int a = gen.uniform(0, n - 1);
+        int b = gen.uniform(0, n - 1);
+        ASSERT_EQ(uf.same(a, b), your_uf.is_connect(a, b))
+            << "a = " << a << ", b = " << b;
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(ConcurrentUnionFindTest, StressTest, LargeStressTest);
+
 }  // namespace algotest
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "../random.h"
+
+// 畳み込みの検証に使う"正しい"関数群
+namespace algotest {
+
+namespace convolution {
+
+/// 多項式の積の検証に使う法 (2^61 - 1, 素数)
+constexpr uint64_t kCheckMod = (1ULL << 61) - 1;
+
+inline uint64_t mul_mod(uint64_t x, uint64_t y, uint64_t mod) {
+    return uint64_t((unsigned __int128)(x) * y % mod);
+}
+
+/// a(x) mod m を返す (a_i は負でもよい)
+inline uint64_t eval_mod(const std::vector<long long>& a,
+                         uint64_t x,
+                         uint64_t mod) {
+    uint64_t res = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+        long long r = a[i] % (long long)(mod);
+        uint64_t c = uint64_t(r < 0 ? r + (long long)(mod) : r);
+        res = mul_mod(res, x, mod) + c;
+        if (res >= mod)
+            res -= mod;
+    }
+    return res;
+}
+
+/**
+ * c = a * b (mod m) を乱択で検証する
+ * ランダムな点 x で a(x) b(x) = c(x) を trial 回確かめる (Schwartz-Zippel)
+ * 誤判定の確率は (deg / m)^trial 以下
+ */
+inline bool check_multiply(const std::vector<long long>& a,
+                           const std::vector<long long>& b,
+                           const std::vector<long long>& c,
+                           uint64_t mod,
+                           algotest::random::Random& gen,
+                           int trial = 4) {
+    if (c.size() != a.size() + b.size() - 1)
+        return false;
+    for (int ph = 0; ph < trial; ph++) {
+        uint64_t x = gen.uniform(uint64_t(0), mod - 1);
+        uint64_t l = mul_mod(eval_mod(a, x, mod), eval_mod(b, x, mod), mod);
+        if (l != eval_mod(c, x, mod))
+            return false;
+    }
+    return true;
+}
+
+/// NTT に使う素数 mod = c 2^k + 1 (< 2^31) と原始根
+struct NTTPrime {
+    uint32_t mod, root;
+};
+
+/// NTT ができる素数, 長さは 2^23 まで (998244353 = 119 2^23 + 1 が最小)
+constexpr NTTPrime kNTTPrimes[] = {
+    {998244353, 3},  {167772161, 3},  {469762049, 3},
+    {754974721, 11}, {1224736769, 3}, {2013265921, 31},
+};
+constexpr int kNTTPrimeCount = 6;
+
+inline uint32_t pow_mod32(uint64_t x, uint64_t n, uint32_t mod) {
+    uint64_t r = 1;
+    x %= mod;
+    while (n) {
+        if (n & 1)
+            r = r * x % mod;
+        x = x * x % mod;
+        n >>= 1;
+    }
+    return uint32_t(r);
+}
+
+/// a (長さは 2 冪) を p で NTT する, inverse なら逆変換 (1 / n 倍まで)
+inline void ntt(std::vector<uint32_t>& a, bool inverse, NTTPrime p) {
+    const uint64_t mod = p.mod;
+    size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+    std::vector<uint32_t> w(n / 2 + 1);
+    for (size_t len = 2; len <= n; len <<= 1) {
+        uint64_t wl = pow_mod32(p.root, (mod - 1) / len, p.mod);
+        if (inverse)
+            wl = pow_mod32(wl, mod - 2, p.mod);
+        w[0] = 1;
+        for (size_t i = 1; i < len / 2; i++)
+            w[i] = uint32_t(w[i - 1] * wl % mod);
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < len / 2; j++) {
+                uint64_t u = a[i + j];
+                uint64_t v = a[i + j + len / 2] * uint64_t(w[j]) % mod;
+                a[i + j] = uint32_t(u + v >= mod ? u + v - mod : u + v);
+                a[i + j + len / 2] = uint32_t(u >= v ? u - v : u + mod - v);
+            }
+        }
+    }
+    if (inverse) {
+        uint64_t inv_n = pow_mod32(n, mod - 2, p.mod);
+        for (auto& x : a)
+            x = uint32_t(x * inv_n % mod);
+    }
+}
+
+/// a * b mod p (a_i, b_i >= 0), 長さ |a| + |b| - 1
+inline std::vector<uint32_t> multiply_ntt(const std::vector<long long>& a,
+                                          const std::vector<long long>& b,
+                                          NTTPrime p) {
+    size_t len = a.size() + b.size() - 1, n = 1;
+    while (n < len)
+        n <<= 1;
+    std::vector<uint32_t> fa(n), fb(n);
+    for (size_t i = 0; i < a.size(); i++)
+        fa[i] = uint32_t(uint64_t(a[i]) % p.mod);
+    for (size_t i = 0; i < b.size(); i++)
+        fb[i] = uint32_t(uint64_t(b[i]) % p.mod);
+    ntt(fa, false, p);
+    ntt(fb, false, p);
+    for (size_t i = 0; i < n; i++)
+        fa[i] = uint32_t(uint64_t(fa[i]) * fb[i] % p.mod);
+    ntt(fa, true, p);
+    fa.resize(len);
+    return fa;
+}
+
+/**
+ * 正確な a * b (a_i, b_i >= 0), 先頭 3 素数の NTT と CRT による
+ * 各係数が 3 素数の積 (約 7.8 * 10^25) 未満であること
+ */
+inline std::vector<__int128> multiply_exact(const std::vector<long long>& a,
+                                            const std::vector<long long>& b) {
+    const NTTPrime* ps = kNTTPrimes;
+    auto r0 = multiply_ntt(a, b, ps[0]);
+    auto r1 = multiply_ntt(a, b, ps[1]);
+    auto r2 = multiply_ntt(a, b, ps[2]);
+    const uint64_t m0 = ps[0].mod, m1 = ps[1].mod, m2 = ps[2].mod;
+    const uint64_t m0_inv_m1 = pow_mod32(m0, m1 - 2, ps[1].mod);
+    const uint64_t m01_inv_m2 = pow_mod32(m0 * m1 % m2, m2 - 2, ps[2].mod);
+    std::vector<__int128> c(r0.size());
+    for (size_t i = 0; i < c.size(); i++) {
+        // Garner: x = x0 + x1 m0 + x2 m0 m1
+        uint64_t x0 = r0[i];
+        uint64_t x1 = (r1[i] + m1 - x0 % m1) % m1 * m0_inv_m1 % m1;
+        uint64_t t = (x0 + x1 * m0) % m2;
+        uint64_t x2 = (r2[i] + m2 - t) % m2 * m01_inv_m2 % m2;
+        c[i] = __int128(x0) + __int128(x1) * m0 + __int128(x2) * m0 * m1;
+    }
+    return c;
+}
+
+/// a * b mod m を愚直に (O(|a| |b|))
+inline std::vector<long long> multiply_naive(const std::vector<long long>& a,
+                                             const std::vector<long long>& b,
+                                             uint64_t mod) {
+    std::vector<long long> c(a.size() + b.size() - 1);
+    for (size_t i = 0; i < a.size(); i++) {
+        for (size_t j = 0; j < b.size(); j++) {
+            uint64_t x = uint64_t(c[i + j]) + mul_mod(a[i], b[j], mod);
+            c[i + j] = (long long)(x >= mod ? x - mod : x);
+        }
+    }
+    return c;
+}
+
+/**
+ * a * b mod m (0 <= a_i, b_i < m < 2^63, m は素数でなくてよい)
+ * 素数の積が係数の上限 min(|a|, |b|) (m - 1)^2 を超えるまで kNTTPrimes の
+ * NTT で計算し, Garner で m に戻す
+ * |a| + |b| - 1 <= 2^23 であること
+ */
+inline std::vector<long long> multiply_mod(const std::vector<long long>& a,
+                                           const std::vector<long long>& b,
+                                           uint64_t mod) {
+    if (std::min(a.size(), b.size()) <= 64)
+        return multiply_naive(a, b, mod);
+    // 必要なビット数 (切り上げ気味に)
+    double need = std::log2(double(std::min(a.size(), b.size()))) +
+                  2 * std::log2(double(mod)) + 1;
+    int k = 0;
+    double have = 0;
+    while (have < need) {
+        assert(k < kNTTPrimeCount);
+        have += std::log2(double(kNTTPrimes[k].mod));
+        k++;
+    }
+    std::vector<std::vector<uint32_t>> r(k);
+    for (int i = 0; i < k; i++)
+        r[i] = multiply_ntt(a, b, kNTTPrimes[i]);
+    // x = x_0 + x_1 m_0 + x_2 m_0 m_1 + ...
+    // prod[i][j] = m_0 ... m_{i-1} mod m_j
+    std::vector<std::vector<uint64_t>> prod(k + 1,
+                                            std::vector<uint64_t>(k + 1));
+    std::vector<uint64_t> mods(k + 1), inv(k);
+    for (int j = 0; j < k; j++)
+        mods[j] = kNTTPrimes[j].mod;
+    mods[k] = mod;
+    for (int j = 0; j <= k; j++) {
+        prod[0][j] = 1 % mods[j];
+        for (int i = 0; i < k; i++)
+            prod[i + 1][j] = mul_mod(prod[i][j], kNTTPrimes[i].mod, mods[j]);
+    }
+    for (int j = 0; j < k; j++)
+        inv[j] = pow_mod32(prod[j][j], mods[j] - 2, kNTTPrimes[j].mod);
+    std::vector<long long> c(r[0].size());
+    // acc[j] = x_0 + ... + x_{i-1} m_0 ... m_{i-2} mod m_j
+    // j < k は m_j < 2^31 なので 64 bit で掛けられる, m だけ 128 bit
+    std::vector<uint64_t> acc(k + 1);
+    for (size_t t = 0; t < c.size(); t++) {
+        std::fill(acc.begin(), acc.end(), 0);
+        for (int i = 0; i < k; i++) {
+            uint64_t x = (r[i][t] + mods[i] - acc[i]) % mods[i] * inv[i] %
+                         mods[i];
+            for (int j = i + 1; j < k; j++)
+                acc[j] = (acc[j] + x * prod[i][j]) % mods[j];
+            acc[k] += mul_mod(x, prod[i][k], mod);
+            if (acc[k] >= mod)
+                acc[k] -= mod;
+        }
+        c[t] = (long long)(acc[k]);
+    }
+    return c;
+}
+
+}  // namespace convolution
+
+}  // namespace algotest
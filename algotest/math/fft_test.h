@@ -1,5 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -12,9 +17,30 @@ class FFTTesterBase {
                                             std::vector<long long> b) = 0;
 };
 
+/// 丸める前の double の FFT の出力を見て, どこまで正確かを測る版
+class FFTPrecisionTesterBase {
+  private:
+    // a, bの積を double の FFT で計算し, 丸める前の値を返す
+    // (0 <= a_i, b_i <= 10^9, 長さ |a| + |b| - 1)
+    virtual std::vector<double> multiply_raw(std::vector<long long> a,
+                                             std::vector<long long> b) = 0;
+    // |a| = n, |b| = m, 0 <= a_i, b_i <= max_coef のとき multiply_raw の
+    // 誤差が 0.5 未満になる (丸めれば正確な積になる) と保証できるか
+    virtual bool is_safe(int n, int m, long long max_coef) = 0;
+};
+
+/// 係数を分割する (split, 3 回の FFT など) ことで 10^9 の係数まで正確に掛ける版
+class FFTSplitTesterBase {
+  private:
+    // a, bの正確な積を返す (0 <= a_i, b_i <= 10^9, |a| + |b| - 1 <= 2^22)
+    virtual std::vector<__int128> multiply(std::vector<long long> a,
+                                           std::vector<long long> b) = 0;
+};
+
 }  // namespace algotest
 
 #include "../random.h"
+#include "convolution.h"
 
 namespace algotest {
 
@@ -49,6 +75,299 @@ TYPED_TEST_P(FFTTest, StressTest) {
     }
 }
 
-REGISTER_TYPED_TEST_CASE_P(FFTTest, StressTest);
+/// 2^20 ~ 2^23 項の積, a(x) * b(x) = c(x) をランダムな点で確かめる
+TYPED_TEST_P(FFTTest, LargeStressTest) {
+    using V = std::vector<long long>;
+    const std::vector<std::pair<int, int>> sizes = {
+        {1 << 19, (1 << 19) + 1}, {1 << 20, 1 << 20},
+        {(1 << 21) + 1, (1 << 21) - 1}, {3 << 20, 1 << 20},
+        {1, 1 << 22}, {1 << 22, 1 << 22},
+    };
+    algotest::random::Random gen;
+
+    for (auto sz : sizes) {
+        TypeParam your_fft;
+        V a = gen.uniform_vector(sz.first, 0LL, 100LL);
+        V b = gen.uniform_vector(sz.second, 0LL, 100LL);
+
+        auto out = your_fft.multiply(a, b);
+        ASSERT_EQ(a.size() + b.size() - 1, out.size());
+        ASSERT_TRUE(
+            convolution::check_multiply(a, b, out, convolution::kCheckMod, gen))
+            << "|a| = " << a.size() << ", |b| = " << b.size();
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(FFTTest, StressTest, LargeStressTest);
+
+template <class FFT>
+class FFTPrecisionTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(FFTPrecisionTest);
+
+namespace convolution {
+
+/// |raw - exact|, raw が有限でなければ inf
+inline double raw_error(double raw, __int128 exact) {
+    if (!std::isfinite(raw) || std::abs(raw) >= std::ldexp(1.0, 120))
+        return std::numeric_limits<double>::infinity();
+    // floor(raw) は整数なので __int128 に正確に入り, raw - floor(raw) も正確
+    double fl = std::floor(raw);
+    return std::abs(double((__int128)(fl)-exact) + (raw - fl));
+}
+
+/**
+ * 長さ n の a, b を作って正確な積を返す
+ * pattern 0 は [0, mag] の一様乱数, 1 は全て mag (FFT の誤差が最も大きい)
+ */
+inline std::vector<__int128> gen_precision_case(algotest::random::Random& gen,
+                                                int n,
+                                                long long mag,
+                                                int pattern,
+                                                std::vector<long long>& a,
+                                                std::vector<long long>& b) {
+    if (pattern == 0) {
+        a = gen.uniform_vector(n, 0LL, mag);
+        b = gen.uniform_vector(n, 0LL, mag);
+        return multiply_exact(a, b);
+    }
+    a.assign(n, mag);
+    b.assign(n, mag);
+    // c_k = mag^2 * (項の数)
+    std::vector<__int128> ans(2 * n - 1);
+    for (int k = 0; k < 2 * n - 1; k++)
+        ans[k] = __int128(mag) * mag * (std::min(k, 2 * n - 2 - k) + 1);
+    return ans;
+}
+
+/// 失敗時に出す文字列
+inline std::string to_string(__int128 x) {
+    if (x < 0)
+        return "-" + to_string(-x);
+    std::string s;
+    do {
+        s += char('0' + int(x % 10));
+        x /= 10;
+    } while (x);
+    return std::string(s.rbegin(), s.rend());
+}
+
+/**
+ * 出力の長さ size - 1 (|a| = |b| = size / 2), 係数の上限 10^2 ~ 10^9 で
+ * multiply_raw の最大誤差を測り, "err_<pattern>_<size>_<max_coef>" として残す
+ * pattern は uniform ([0, max_coef] の一様乱数) と max (全て max_coef, 誤差が最も大きい)
+ * is_safe が true なのに誤差が 0.5 以上なら失敗
+ * 出力の長さ kSafeSize 以下, 係数 kSafeCoef 以下はどんな double の FFT でも
+ * 正確なはずなので, is_safe によらず誤差 0.5 未満を要求する
+ * is_safe が true になる最大の係数を "safe_<size>" として残す (なければ 0)
+ */
+constexpr int kSafeSize = 1 << 10;
+constexpr long long kSafeCoef = 100;
+
+template <class FFT>
+void check_precision(int size) {
+    using V = std::vector<long long>;
+    algotest::random::Random gen;
+    const int n = size / 2;
+    long long max_safe = 0;
+    for (long long mag = 100; mag <= 1000000000; mag *= 10) {
+        FFT your_fft;
+        if (your_fft.is_safe(n, n, mag))
+            max_safe = mag;
+    }
+    ::testing::Test::RecordProperty("safe_" + std::to_string(size),
+                                    std::to_string(max_safe));
+    for (int pattern = 0; pattern < 2; pattern++) {
+        for (long long mag = 100; mag <= 1000000000; mag *= 10) {
+            V a, b;
+            auto ans = gen_precision_case(gen, n, mag, pattern, a, b);
+            FFT your_fft;
+            bool safe = your_fft.is_safe(n, n, mag);
+            bool required = size <= kSafeSize && mag <= kSafeCoef;
+            if (required) {
+                ASSERT_TRUE(safe) << "is_safe(" << n << ", " << n << ", "
+                                  << mag << ") must be true";
+            }
+            auto out = your_fft.multiply_raw(a, b);
+            ASSERT_EQ(size_t(2 * n - 1), out.size());
+            double err = 0;
+            size_t worst = 0;
+            for (size_t i = 0; i < ans.size(); i++) {
+                double e = raw_error(out[i], ans[i]);
+                if (!(e <= err)) {
+                    err = e;
+                    worst = i;
+                }
+            }
+            std::string name = std::string(pattern ? "max" : "uniform") + "_" +
+                               std::to_string(size) + "_" +
+                               std::to_string(mag);
+            std::ostringstream os;
+            os << err;
+            ::testing::Test::RecordProperty("err_" + name, os.str());
+            if (safe || required) {
+                ASSERT_LT(err, 0.5)
+                    << name << ": c[" << worst << "] = " << out[worst]
+                    << ", expected " << to_string(ans[worst]);
+            }
+        }
+    }
+}
+
+/**
+ * is_safe が単調か, つまり true になる (n, m, max_coef) より n, m, max_coef の
+ * どれかを小さくしても true のままかを確かめる
+ * n, m は 1 ~ 2^21, max_coef は 1 ~ 10^9 の格子で見る
+ */
+template <class FFT>
+void check_safe_monotone() {
+    std::vector<int> ns;
+    for (int lg = 0; lg <= 21; lg += 3)
+        ns.push_back(1 << lg);
+    std::vector<long long> mags;
+    for (long long mag = 1; mag <= 1000000000; mag *= 10)
+        mags.push_back(mag);
+    const size_t N = ns.size(), M = mags.size();
+    std::vector<char> safe(N * N * M);
+    auto id = [&](size_t i, size_t j, size_t k) { return (i * N + j) * M + k; };
+    FFT your_fft;
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = 0; j < N; j++) {
+            for (size_t k = 0; k < M; k++)
+                safe[id(i, j, k)] = your_fft.is_safe(ns[i], ns[j], mags[k]);
+        }
+    }
+    auto point = [&](size_t i, size_t j, size_t k) {
+        return "(" + std::to_string(ns[i]) + ", " + std::to_string(ns[j]) +
+               ", " + std::to_string(mags[k]) + ")";
+    };
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = 0; j < N; j++) {
+            for (size_t k = 0; k < M; k++) {
+                if (!safe[id(i, j, k)])
+                    continue;
+                if (i > 0) {
+                    ASSERT_TRUE(safe[id(i - 1, j, k)])
+                        << point(i, j, k) << " is safe but "
+                        << point(i - 1, j, k) << " is not";
+                }
+                if (j > 0) {
+                    ASSERT_TRUE(safe[id(i, j - 1, k)])
+                        << point(i, j, k) << " is safe but "
+                        << point(i, j - 1, k) << " is not";
+                }
+                if (k > 0) {
+                    ASSERT_TRUE(safe[id(i, j, k - 1)])
+                        << point(i, j, k) << " is safe but "
+                        << point(i, j, k - 1) << " is not";
+                }
+            }
+        }
+    }
+}
+
+}  // namespace convolution
+
+/// is_safe が (n, m, max_coef) について単調か
+TYPED_TEST_P(FFTPrecisionTest, SafeMonotoneTest) {
+    convolution::check_safe_monotone<TypeParam>();
+}
+
+/// 出力の長さ 2^10, 2^14, 2^18 で誤差を測る
+TYPED_TEST_P(FFTPrecisionTest, PrecisionTest) {
+    for (int size : {1 << 10, 1 << 14, 1 << 18}) {
+        convolution::check_precision<TypeParam>(size);
+        if (this->HasFatalFailure())
+            return;
+    }
+}
+
+/// 出力の長さ 2^22 で誤差を測る
+TYPED_TEST_P(FFTPrecisionTest, LargePrecisionTest) {
+    convolution::check_precision<TypeParam>(1 << 22);
+}
+
+REGISTER_TYPED_TEST_CASE_P(FFTPrecisionTest,
+                           SafeMonotoneTest,
+                           PrecisionTest,
+                           LargePrecisionTest);
+
+template <class FFT>
+class FFTSplitTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(FFTSplitTest);
+
+namespace convolution {
+
+/// check_precision と同じケースで, FFTSplitTesterBase::multiply が正確か
+template <class FFT>
+void check_split(int size) {
+    algotest::random::Random gen;
+    const int n = size / 2;
+    for (int pattern = 0; pattern < 2; pattern++) {
+        for (long long mag = 100; mag <= 1000000000; mag *= 10) {
+            std::vector<long long> a, b;
+            auto ans = gen_precision_case(gen, n, mag, pattern, a, b);
+            FFT your_fft;
+            auto out = your_fft.multiply(a, b);
+            ASSERT_EQ(ans.size(), out.size());
+            for (size_t i = 0; i < ans.size(); i++) {
+                ASSERT_TRUE(ans[i] == out[i])
+                    << (pattern ? "max" : "uniform") << ", size = " << size
+                    << ", max_coef = " << mag << ": c[" << i
+                    << "] = " << to_string(out[i]) << ", expected "
+                    << to_string(ans[i]);
+            }
+        }
+    }
+}
+
+}  // namespace convolution
+
+/// 長さ 1 ~ 29 の積を愚直と比べる (0 <= a_i, b_i <= 10^9)
+TYPED_TEST_P(FFTSplitTest, StressTest) {
+    static const int N = 30;
+    const long long mx = 1000000000;
+    algotest::random::Random gen;
+
+    for (int a_sz = 1; a_sz < N; a_sz++) {
+        for (int b_sz = 1; b_sz < N; b_sz++) {
+            auto a = gen.uniform_vector(a_sz, 0LL, mx);
+            auto b = gen.uniform_vector(b_sz, 0LL, mx);
+            if ((a_sz + b_sz) % 4 == 0) {
+                a.assign(a_sz, mx);
+                b.assign(b_sz, mx);
+            }
+            std::vector<__int128> ans(a_sz + b_sz - 1);
+            for (int i = 0; i < a_sz; i++) {
+                for (int j = 0; j < b_sz; j++) {
+                    ans[i + j] += __int128(a[i]) * b[j];
+                }
+            }
+            TypeParam your_fft;
+            ASSERT_TRUE(ans == your_fft.multiply(a, b))
+                << "|a| = " << a_sz << ", |b| = " << b_sz;
+        }
+    }
+}
+
+/// 出力の長さ 2^10, 2^14, 2^18, 係数の上限 10^2 ~ 10^9 で NTT + CRT と比べる
+TYPED_TEST_P(FFTSplitTest, PrecisionTest) {
+    for (int size : {1 << 10, 1 << 14, 1 << 18}) {
+        convolution::check_split<TypeParam>(size);
+        if (this->HasFatalFailure())
+            return;
+    }
+}
+
+/// 出力の長さ 2^22 で NTT + CRT と比べる
+TYPED_TEST_P(FFTSplitTest, LargePrecisionTest) {
+    convolution::check_split<TypeParam>(1 << 22);
+}
+
+REGISTER_TYPED_TEST_CASE_P(FFTSplitTest,
+                           StressTest,
+                           PrecisionTest,
+                           LargePrecisionTest);
 
 }  // namespace algotest
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
+#include "../span.h"
 
 namespace algotest {
 
@@ -12,8 +14,36 @@ class GCDTesterBase {
                                                     long long y) = 0;
 };
 
+/// まとめて投げる版, batch の値は long long 全体 (INT64_MIN を含む)
+class GCDBatchTesterBase {
+    /// gcd(x, y)を返す (|x|, |y| <= 1e18)
+    virtual long long gcd(long long x, long long y) = 0;
+    /// p.first * x + p.second * y = gcd(x, y)なるpairを返す (|x|, |y| <= 1e18)
+    virtual std::pair<long long, long long> ext_gcd(long long x,
+                                                    long long y) = 0;
+    /**
+     * out[i] = gcd(|x[i]|, |y[i]|), gcd(0, 0) = 0
+     * gcd(INT64_MIN, 0) = 2^63 が入るので uint64_t, 各 Span の長さは等しい
+     */
+    virtual void gcd_batch(Span<const long long> x,
+                           Span<const long long> y,
+                           Span<uint64_t> out) = 0;
+    /**
+     * a[i] x[i] + b[i] y[i] = gcd(x[i], y[i]) (多倍長で成り立てばよい) となる a, b
+     * g = gcd として |a[i]| <= max(1, |y[i]| / 2g), |b[i]| <= max(1, |x[i]| / 2g)
+     * (通常の拡張ユークリッドの係数はこれを満たし, long long に収まる)
+     */
+    virtual void ext_gcd_batch(Span<const long long> x,
+                               Span<const long long> y,
+                               Span<long long> a,
+                               Span<long long> b) = 0;
+};
+
 }  // namespace algotest
 
+#include <limits>
+#include <sstream>
+#include <string>
 #include "../random.h"
 #include "gtest/gtest.h"
 
@@ -65,4 +95,183 @@ TYPED_TEST_P(GCDTest, EXTGCDStressTest) {
 
 REGISTER_TYPED_TEST_CASE_P(GCDTest, GCDStressTest, EXTGCDStressTest);
 
+template <typename GCD>
+class GCDBatchTest : public ::testing::Test {};
+
+namespace gcd {
+
+using i128 = __int128;
+
+/// |x| (INT64_MIN でもよい)
+inline uint64_t abs_u(long long x) {
+    return x < 0 ? 0 - uint64_t(x) : uint64_t(x);
+}
+
+inline uint64_t gcd_u(long long x, long long y) {
+    uint64_t a = abs_u(x), b = abs_u(y);
+    while (b) {
+        a %= b;
+        std::swap(a, b);
+    }
+    return a;
+}
+
+inline i128 abs128(i128 x) {
+    return x < 0 ? -x : x;
+}
+
+/// ext_gcd_batch の結果 (a, b) が正しいか, 正しくなければ理由を返す (正しければ空)
+inline std::string check_bezout(long long x, long long y, long long a, long long b) {
+    uint64_t g = gcd_u(x, y);
+    std::ostringstream os;
+    if (i128(a) * x + i128(b) * y != i128(g)) {
+        os << "a x + b y != " << g;
+    } else if (g != 0 && (abs128(a) * 2 * i128(g) >
+                              std::max(i128(2) * g, i128(abs_u(y))) ||
+                          abs128(b) * 2 * i128(g) >
+                              std::max(i128(2) * g, i128(abs_u(x))))) {
+        os << "|a|, |b| too large";
+    }
+    std::string err = os.str();
+    if (!err.empty())
+        err = "x = " + std::to_string(x) + ", y = " + std::to_string(y) +
+              ", a = " + std::to_string(a) + ", b = " + std::to_string(b) +
+              ": " + err;
+    return err;
+}
+
+/// INT64_MIN / MAX 付近などの境界の値
+inline std::vector<long long> edge_values() {
+    const long long mn = std::numeric_limits<long long>::min();
+    const long long mx = std::numeric_limits<long long>::max();
+    std::vector<long long> v = {mn,           mn + 1,      mn + 2,
+                                mn / 2,       mn / 3,      mx,
+                                mx - 1,       mx / 2,      mx / 3,
+                                0,            1,           -1,
+                                2,            -2,          1LL << 62,
+                                -(1LL << 62), (1LL << 32), 1000000000000000000LL,
+                                -1000000000000000000LL};
+    // 隣り合う Fibonacci 数 (ユークリッドの互除法の最悪ケース)
+    long long f0 = 4660046610375530309LL, f1 = 7540113804746346429LL;
+    v.push_back(f0);
+    v.push_back(f1);
+    v.push_back(-f1);
+    return v;
+}
+
+/// long long 全域の一様乱数 (uniform(min, max) は max - min が溢れる)
+inline long long uniform_ll(random::Random& gen) {
+    return (long long)(gen.uniform(uint64_t(0), ~uint64_t(0)));
+}
+
+/// 種類を混ぜたランダムな (x, y) を n 組
+inline void gen_pairs(random::Random& gen,
+                      int n,
+                      std::vector<long long>& xs,
+                      std::vector<long long>& ys) {
+    auto edges = edge_values();
+    xs.resize(n);
+    ys.resize(n);
+    for (int i = 0; i < n; i++) {
+        long long x, y;
+        switch (gen.uniform(0, 4)) {
+            case 0:  // 全域
+                x = uniform_ll(gen);
+                y = uniform_ll(gen);
+                break;
+            case 1: {  // 大きな公約数
+                long long g = gen.uniform(1LL, 1LL << 40);
+                x = g * gen.uniform(-(1LL << 22), 1LL << 22);
+                y = g * gen.uniform(-(1LL << 22), 1LL << 22);
+                break;
+            }
+            case 2:  // 境界
+                x = edges[gen.uniform(size_t(0), edges.size() - 1)];
+                y = edges[gen.uniform(size_t(0), edges.size() - 1)];
+                break;
+            case 3:  // 小さい
+                x = gen.uniform(-100LL, 100LL);
+                y = gen.uniform(-100LL, 100LL);
+                break;
+            default:  // 片方だけ大きい
+                x = uniform_ll(gen);
+                y = gen.uniform(-1000LL, 1000LL);
+                break;
+        }
+        if (gen.uniform_bool())
+            std::swap(x, y);
+        xs[i] = x;
+        ys[i] = y;
+    }
+}
+
+}  // namespace gcd
+
+TYPED_TEST_CASE_P(GCDBatchTest);
+
+/// 境界の値の全ての組
+TYPED_TEST_P(GCDBatchTest, EdgeTest) {
+    auto edges = gcd::edge_values();
+    std::vector<long long> xs, ys;
+    for (long long x : edges) {
+        for (long long y : edges) {
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+    }
+    size_t n = xs.size();
+    std::vector<uint64_t> g(n);
+    std::vector<long long> a(n), b(n);
+    TypeParam your_gcd;
+    your_gcd.gcd_batch(xs, ys, g);
+    your_gcd.ext_gcd_batch(xs, ys, a, b);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(gcd::gcd_u(xs[i], ys[i]), g[i])
+            << "x = " << xs[i] << ", y = " << ys[i];
+        std::string err = gcd::check_bezout(xs[i], ys[i], a[i], b[i]);
+        ASSERT_TRUE(err.empty()) << err;
+    }
+}
+
+/// 10^6 組を1回のバッチで
+TYPED_TEST_P(GCDBatchTest, StressTest) {
+    auto gen = algotest::random::Random();
+    int n = 1000000;
+    std::vector<long long> xs, ys;
+    gcd::gen_pairs(gen, n, xs, ys);
+    std::vector<uint64_t> g(n);
+    std::vector<long long> a(n), b(n);
+    TypeParam your_gcd;
+    your_gcd.gcd_batch(xs, ys, g);
+    your_gcd.ext_gcd_batch(xs, ys, a, b);
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ(gcd::gcd_u(xs[i], ys[i]), g[i])
+            << "x = " << xs[i] << ", y = " << ys[i];
+        std::string err = gcd::check_bezout(xs[i], ys[i], a[i], b[i]);
+        ASSERT_TRUE(err.empty()) << err;
+    }
+}
+
+/// 長さ 0 ~ 64 のバッチ (SIMD の端数処理)
+TYPED_TEST_P(GCDBatchTest, ShortBatchTest) {
+    auto gen = algotest::random::Random();
+    TypeParam your_gcd;
+    for (int n = 0; n <= 64; n++) {
+        std::vector<long long> xs, ys;
+        gcd::gen_pairs(gen, n, xs, ys);
+        std::vector<uint64_t> g(n);
+        std::vector<long long> a(n), b(n);
+        your_gcd.gcd_batch(xs, ys, g);
+        your_gcd.ext_gcd_batch(xs, ys, a, b);
+        for (int i = 0; i < n; i++) {
+            ASSERT_EQ(gcd::gcd_u(xs[i], ys[i]), g[i])
+                << "n = " << n << ", x = " << xs[i] << ", y = " << ys[i];
+            std::string err = gcd::check_bezout(xs[i], ys[i], a[i], b[i]);
+            ASSERT_TRUE(err.empty()) << "n = " << n << ", " << err;
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(GCDBatchTest, EdgeTest, StressTest, ShortBatchTest);
+
 }  // namespace algotest
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <limits>
 #include <vector>
+#include "../span.h"
 #include "gtest/gtest.h"
 
 namespace algotest {
@@ -16,9 +18,35 @@ class NFTTesterBase {
                                             std::vector<long long> b) = 0;
 };
 
+/// 入力をコピーせずに受け取る版
+class NFTViewTesterBase {
+  public:
+    static constexpr long long kMod = 998244353;
+    static constexpr long long kG = 3;  // primitive root
+
+  private:
+    // a, bを多項式として見たときの積を返す(MOD 998244353)
+    virtual std::vector<long long> multiply(Span<const long long> a,
+                                            Span<const long long> b) = 0;
+};
+
+/// 任意の法 (NTT に向かない法, 合成数を含む) での積
+class NFTArbitraryModTesterBase {
+  private:
+    // a, bを多項式として見たときの積を返す
+    // (MOD mod, 2 <= mod < 2^63, 0 <= a_i, b_i < mod, |a| + |b| - 1 <= 2^22)
+    virtual std::vector<long long> multiply(std::vector<long long> a,
+                                            std::vector<long long> b,
+                                            long long mod) = 0;
+};
+
 }  // namespace algotest
 
+#include "../alloc.h"
+#include "../complexity.h"
+#include "../perf.h"
 #include "../random.h"
+#include "convolution.h"
 
 namespace algotest {
 
@@ -56,6 +84,253 @@ TYPED_TEST_P(NFTTest, StressTest) {
     }
 }
 
-REGISTER_TYPED_TEST_CASE_P(NFTTest, StressTest);
+/// 2^20 ~ 2^23 項の積, a(x) * b(x) = c(x) をランダムな点で確かめる
+TYPED_TEST_P(NFTTest, LargeStressTest) {
+    using ll = long long;
+    using V = std::vector<long long>;
+    constexpr ll kMod = NFTTesterBase::kMod;
+    const std::vector<std::pair<int, int>> sizes = {
+        {1 << 19, (1 << 19) + 1}, {1 << 20, 1 << 20},
+        {(1 << 21) + 1, (1 << 21) - 1}, {3 << 20, 1 << 20},
+        {1, 1 << 22}, {1 << 22, 1 << 22},
+    };
+    algotest::random::Random gen;
+
+    for (auto sz : sizes) {
+        TypeParam your_nft;
+        V a = gen.uniform_vector(sz.first, 0LL, kMod - 1);
+        V b = gen.uniform_vector(sz.second, 0LL, kMod - 1);
+
+        V out;
+        perf::Result pr = perf::measure([&] { out = your_nft.multiply(a, b); });
+        // 出力1項あたりのカウンタを XML 出力に残す (取れなければ何もしない)
+        pr.each([&](const std::string& name, double v) {
+            ::testing::Test::RecordProperty(
+                "multiply_" + std::to_string(a.size()) + "x" +
+                    std::to_string(b.size()) + "_" + name,
+                std::to_string(v / double(out.size())));
+        });
+        ASSERT_EQ(a.size() + b.size() - 1, out.size());
+        for (auto x : out) {
+            ASSERT_TRUE(0 <= x && x < kMod);
+        }
+        ASSERT_TRUE(convolution::check_multiply(a, b, out, kMod, gen))
+            << "|a| = " << a.size() << ", |b| = " << b.size();
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(NFTTest, StressTest, LargeStressTest);
+
+template <class NFT>
+class NFTComplexityTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(NFTComplexityTest);
+
+/// n = 2^10 ~ 2^22 で実行時間を測り, O(n log n) から外れていないか見る
+TYPED_TEST_P(NFTComplexityTest, MultiplyTest) {
+    using ll = long long;
+    using V = std::vector<long long>;
+    constexpr ll kMod = NFTTesterBase::kMod;
+    algotest::random::Random gen;
+    std::vector<complexity::Sample> samples;
+
+    for (int lg = 10; lg <= 22; lg += 2) {
+        int n = 1 << lg;
+        V a = gen.uniform_vector(n, 0LL, kMod - 1);
+        V b = gen.uniform_vector(n, 0LL, kMod - 1);
+        // measure の中の ASSERT は lambda から抜けるだけなので, 外で確かめる
+        int out_size = -1;
+        double sec = complexity::measure([&] {
+            TypeParam your_nft;
+            auto out = your_nft.multiply(a, b);
+            out_size = int(out.size());
+        });
+        ASSERT_EQ(2 * n - 1, out_size) << "n = " << n;
+        samples.push_back(complexity::Sample{double(n), sec});
+    }
+    double excess = complexity::excess_exponent(samples, complexity::n_log_n);
+    ASSERT_LE(excess, complexity::kMaxExcess) << complexity::dump(samples);
+}
+
+REGISTER_TYPED_TEST_CASE_P(NFTComplexityTest, MultiplyTest);
+
+template <class NFT>
+class NFTAllocTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(NFTAllocTest);
+
+/**
+ * multiply の中で確保するメモリの量を見る (ALGOTEST_ALLOC_HOOKS() がなければ何もしない)
+ * 長さ N = 2^k >= |a| + |b| - 1 の配列を高々 16 本ぶん, 回数は O(log N) まで
+ */
+TYPED_TEST_P(NFTAllocTest, MultiplyTest) {
+    using ll = long long;
+    using V = std::vector<long long>;
+    constexpr ll kMod = NFTTesterBase::kMod;
+    if (!alloc::installed())
+        return;
+    algotest::random::Random gen;
+    for (int lg = 10; lg <= 20; lg += 5) {
+        int n = 1 << lg;
+        V a = gen.uniform_vector(n, 0LL, kMod - 1);
+        V b = gen.uniform_vector(n, 0LL, kMod - 1);
+        size_t len = size_t(2) << lg;
+        TypeParam your_nft;
+        V out;
+        alloc::Stats st = alloc::measure(
+            [&] { out = your_nft.multiply(std::move(a), std::move(b)); });
+        ASSERT_EQ(2 * n - 1, int(out.size()));
+        ASSERT_LE(st.peak, 16 * len * sizeof(ll)) << "n = " << n << ", "
+                                                  << alloc::dump(st);
+        ASSERT_LE(st.count, size_t(8 * (lg + 1)))
+            << "n = " << n << ", " << alloc::dump(st);
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(NFTAllocTest, MultiplyTest);
+
+template <class NFT>
+class NFTViewTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(NFTViewTest);
+
+TYPED_TEST_P(NFTViewTest, StressTest) {
+    using ll = long long;
+    using V = std::vector<long long>;
+    constexpr ll kMod = NFTViewTesterBase::kMod;
+    algotest::random::Random gen;
+
+    for (int a_sz = 1; a_sz < 30; a_sz++) {
+        for (int b_sz = 1; b_sz < 30; b_sz++) {
+            TypeParam your_nft;
+            V a = gen.uniform_vector(a_sz, 0LL, kMod - 1);
+            V b = gen.uniform_vector(b_sz, 0LL, kMod - 1);
+            V ans(a_sz + b_sz - 1);
+            for (int i = 0; i < a_sz; i++) {
+                for (int j = 0; j < b_sz; j++) {
+                    ans[i + j] = (ans[i + j] + a[i] * b[j]) % kMod;
+                }
+            }
+            ASSERT_EQ(ans, your_nft.multiply(a, b));
+        }
+    }
+}
+
+/// 2^22 項同士の積, 入力は部分列 (先頭がずれた Span) で渡す
+TYPED_TEST_P(NFTViewTest, LargeStressTest) {
+    using ll = long long;
+    using V = std::vector<long long>;
+    constexpr ll kMod = NFTViewTesterBase::kMod;
+    algotest::random::Random gen;
+    const size_t n = 1 << 22;
+    V buf = gen.uniform_vector(2 * n + 3, 0LL, kMod - 1);
+    Span<const ll> all(buf);
+    Span<const ll> a = all.subspan(1, n), b = all.subspan(n + 2, n + 1);
+
+    TypeParam your_nft;
+    V out = your_nft.multiply(a, b);
+    ASSERT_EQ(a.size() + b.size() - 1, out.size());
+    for (auto x : out) {
+        ASSERT_TRUE(0 <= x && x < kMod);
+    }
+    ASSERT_TRUE(convolution::check_multiply(V(a.begin(), a.end()),
+                                            V(b.begin(), b.end()), out, kMod,
+                                            gen));
+}
+
+REGISTER_TYPED_TEST_CASE_P(NFTViewTest, StressTest, LargeStressTest);
+
+template <class NFT>
+class NFTArbitraryModTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(NFTArbitraryModTest);
+
+namespace convolution {
+
+/// NTT に向かない法, 境界の法
+inline std::vector<long long> arbitrary_mods() {
+    return {
+        2,
+        1000000007,
+        998244353,
+        1LL << 32,
+        (1LL << 61) - 1,
+        1000000000000000009,  // 10^18 + 9
+        9223372036854775783,  // 2^63 未満で最大の素数
+        // 2^63 - 1 = 7^2 * 73 * 127 * 337 * 92737 * 649657
+        9223372036854775807,
+    };
+}
+
+/// 長さ n, [0, mod) の一様乱数 (full なら全て mod - 1, 積の係数が最大)
+inline std::vector<long long> gen_poly(algotest::random::Random& gen,
+                                       int n,
+                                       long long mod,
+                                       bool full) {
+    if (full)
+        return std::vector<long long>(n, mod - 1);
+    return gen.uniform_vector(n, 0LL, mod - 1);
+}
+
+}  // namespace convolution
+
+/// 長さ 1 ~ 29 の積を愚直と比べる, 法は arbitrary_mods() とランダムな値
+TYPED_TEST_P(NFTArbitraryModTest, StressTest) {
+    using V = std::vector<long long>;
+    static const int N = 30;
+    constexpr long long kMaxMod = std::numeric_limits<long long>::max();
+    auto mods = convolution::arbitrary_mods();
+    algotest::random::Random gen;
+
+    for (int a_sz = 1; a_sz < N; a_sz++) {
+        for (int b_sz = 1; b_sz < N; b_sz++) {
+            int t = a_sz * N + b_sz;
+            long long mod = t % 3 ? mods[t % mods.size()]
+                                  : gen.uniform(2LL, kMaxMod);
+            V a = convolution::gen_poly(gen, a_sz, mod, t % 4 == 0);
+            V b = convolution::gen_poly(gen, b_sz, mod, t % 4 == 0);
+            TypeParam your_nft;
+            ASSERT_EQ(convolution::multiply_naive(a, b, mod),
+                      your_nft.multiply(a, b, mod))
+                << "|a| = " << a_sz << ", |b| = " << b_sz << ", mod = " << mod;
+        }
+    }
+}
+
+/**
+ * 2^20 ~ 2^22 項の積, NTT (最大 6 つ) + Garner の結果と比べる
+ * 参照実装は 5, 6 個の NTT が要る法で重いので, そのケースは 2^21 項まで
+ */
+TYPED_TEST_P(NFTArbitraryModTest, LargeStressTest) {
+    using V = std::vector<long long>;
+    struct Case {
+        int n, m;
+        long long mod;
+        bool full;
+    };
+    const std::vector<Case> cases = {
+        {1 << 21, 1 << 21, 1000000007, false},
+        {(1 << 20) + 1, (1 << 20) - 1, (1LL << 61) - 1, false},
+        {1, 1 << 22, 1000000000000000009, false},
+        {1 << 21, 1 << 21, 9223372036854775783, true},
+        {3 << 18, 1 << 19, 9223372036854775807, false},
+    };
+    algotest::random::Random gen;
+
+    for (auto c : cases) {
+        V a = convolution::gen_poly(gen, c.n, c.mod, c.full);
+        V b = convolution::gen_poly(gen, c.m, c.mod, c.full);
+        TypeParam your_nft;
+        auto out = your_nft.multiply(a, b, c.mod);
+        ASSERT_EQ(a.size() + b.size() - 1, out.size());
+        auto ans = convolution::multiply_mod(a, b, c.mod);
+        for (size_t i = 0; i < ans.size(); i++) {
+            ASSERT_EQ(ans[i], out[i]) << "|a| = " << c.n << ", |b| = " << c.m
+                                      << ", mod = " << c.mod << ", i = " << i;
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(NFTArbitraryModTest, StressTest, LargeStressTest);
 
 }  // namespace algotest
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "../random.h"
+
+// 素数判定・素因数分解の"正しい"関数群 (x < 2^64)
+namespace algotest {
+
+namespace prime {
+
+inline uint64_t mul_mod(uint64_t x, uint64_t y, uint64_t mod) {
+    return uint64_t((unsigned __int128)(x) * y % mod);
+}
+
+inline uint64_t pow_mod(uint64_t x, uint64_t n, uint64_t mod) {
+    uint64_t r = 1 % mod;
+    x %= mod;
+    while (n) {
+        if (n & 1)
+            r = mul_mod(r, x, mod);
+        x = mul_mod(x, x, mod);
+        n >>= 1;
+    }
+    return r;
+}
+
+inline uint64_t gcd(uint64_t a, uint64_t b) {
+    while (b) {
+        a %= b;
+        std::swap(a, b);
+    }
+    return a;
+}
+
+/// 決定的 Miller-Rabin (2^64 未満で正しい底の組)
+inline bool is_prime(uint64_t n) {
+    if (n < 2)
+        return false;
+    for (uint64_t p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+        if (n % p == 0)
+            return n == p;
+    }
+    uint64_t d = n - 1;
+    int s = 0;
+    while (d % 2 == 0) {
+        d /= 2;
+        s++;
+    }
+    for (uint64_t a : {2, 325, 9375, 28178, 450775, 9780504, 1795265022}) {
+        uint64_t x = pow_mod(a, d, n);
+        if (x == 0 || x == 1 || x == n - 1)
+            continue;
+        bool ok = false;
+        for (int i = 1; i < s; i++) {
+            x = mul_mod(x, x, n);
+            if (x == n - 1) {
+                ok = true;
+                break;
+            }
+        }
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+/// n (合成数, 奇数) の非自明な約数 (Pollard の rho, Brent の変種)
+inline uint64_t find_divisor(uint64_t n) {
+    for (uint64_t c = 1;; c++) {
+        auto f = [&](uint64_t x) {
+            uint64_t v = mul_mod(x, x, n) + c;
+            return (v >= n || v < c) ? v - n : v;
+        };
+        uint64_t y = 2, x = 2, q = 1, g = 1, ys = 2;
+        const int m = 128;
+        for (int r = 1; g == 1; r <<= 1) {
+            x = y;
+            for (int i = 0; i < r; i++)
+                y = f(y);
+            for (int k = 0; k < r && g == 1; k += m) {
+                ys = y;
+                for (int i = 0; i < m && i < r - k; i++) {
+                    y = f(y);
+                    q = mul_mod(q, x > y ? x - y : y - x, n);
+                }
+                g = gcd(q, n);
+            }
+        }
+        if (g == n) {
+            // まとめすぎたので1つずつ戻る
+            do {
+                ys = f(ys);
+                g = gcd(x > ys ? x - ys : ys - x, n);
+            } while (g == 1);
+        }
+        if (g != n)
+            return g;
+    }
+}
+
+/// n の素因数 (昇順, 重複あり), factor(1) = {}
+inline std::vector<uint64_t> factor(uint64_t n) {
+    std::vector<uint64_t> res;
+    for (uint64_t p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+        while (n % p == 0) {
+            res.push_back(p);
+            n /= p;
+        }
+    }
+    std::vector<uint64_t> st;
+    if (n > 1)
+        st.push_back(n);
+    while (!st.empty()) {
+        uint64_t x = st.back();
+        st.pop_back();
+        if (is_prime(x)) {
+            res.push_back(x);
+            continue;
+        }
+        uint64_t d = find_divisor(x);
+        st.push_back(d);
+        st.push_back(x / d);
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+/// limit 以下の素数
+inline std::vector<uint32_t> primes_upto(uint32_t limit) {
+    std::vector<char> comp(limit + 1);
+    std::vector<uint32_t> ps;
+    for (uint64_t i = 2; i <= limit; i++) {
+        if (comp[i])
+            continue;
+        ps.push_back(uint32_t(i));
+        for (uint64_t j = i * i; j <= limit; j += i)
+            comp[j] = 1;
+    }
+    return ps;
+}
+
+/**
+ * [lo, hi) の各数が素数か (区間篩), res[x - lo]
+ * ps は sqrt(hi) 以下の素数を全て含むこと
+ */
+inline std::vector<char> sieve_segment(uint64_t lo,
+                                       uint64_t hi,
+                                       const std::vector<uint32_t>& ps) {
+    std::vector<char> res(hi - lo, 1);
+    for (uint64_t x = lo; x < std::min<uint64_t>(hi, 2); x++)
+        res[x - lo] = 0;
+    for (uint64_t p : ps) {
+        if (p * p >= hi)
+            break;
+        uint64_t st = std::max(p * p, (lo + p - 1) / p * p);
+        for (uint64_t j = st; j < hi; j += p)
+            res[j - lo] = 0;
+    }
+    return res;
+}
+
+/// floor(sqrt(n))
+inline uint64_t isqrt(uint64_t n) {
+    uint64_t r = uint64_t(std::sqrt((long double)(n)));
+    while (r * r > n)
+        r--;
+    while ((r + 1) * (r + 1) <= n)
+        r++;
+    return r;
+}
+
+/**
+ * n 以下の素数の個数 (Lucy の方法, O(n^{3/4}) 時間, O(sqrt n) 空間)
+ * small[v] = S(v), large[i] = S(n / i), S(v) は v 以下で今の篩で残っている数の個数
+ */
+inline long long prime_pi(uint64_t n) {
+    if (n < 2)
+        return 0;
+    uint64_t r = isqrt(n);
+    std::vector<long long> small(r + 1), large(r + 1);
+    for (uint64_t i = 1; i <= r; i++) {
+        small[i] = (long long)(i) - 1;
+        large[i] = (long long)(n / i) - 1;
+    }
+    for (uint64_t p = 2; p <= r; p++) {
+        if (small[p] == small[p - 1])
+            continue;
+        long long sp = small[p - 1];
+        uint64_t p2 = p * p;
+        uint64_t lim = std::min(r, n / p2);
+        for (uint64_t i = 1; i <= lim; i++) {
+            uint64_t d = i * p;
+            large[i] -= (d <= r ? large[d] : small[n / d]) - sp;
+        }
+        for (uint64_t v = r; v >= p2; v--)
+            small[v] -= small[v / p] - sp;
+    }
+    return large[1];
+}
+
+/// [lo, hi] のランダムな素数
+inline uint64_t random_prime(random::Random& gen, uint64_t lo, uint64_t hi) {
+    while (true) {
+        uint64_t x = gen.uniform(lo, hi);
+        if (is_prime(x))
+            return x;
+    }
+}
+
+/// 2 つの同じくらいの大きさの素数の積 (hi 以下), Pollard の rho に最も重い
+inline uint64_t random_semiprime(random::Random& gen, uint64_t hi) {
+    uint64_t s = uint64_t(std::sqrt((long double)(hi)));
+    uint64_t p = random_prime(gen, s / 2, s);
+    uint64_t q = random_prime(gen, s / 2, hi / p);
+    return p * q;
+}
+
+/// bound 以下の素数の積 (hi 以下)
+inline uint64_t random_smooth(random::Random& gen,
+                              uint64_t hi,
+                              const std::vector<uint32_t>& ps,
+                              uint32_t bound) {
+    size_t k = std::upper_bound(ps.begin(), ps.end(), bound) - ps.begin();
+    uint64_t x = 1;
+    while (true) {
+        uint64_t p = ps[gen.uniform(size_t(0), k - 1)];
+        if (x > hi / p)
+            return x;
+        x *= p;
+    }
+}
+
+}  // namespace prime
+
+}  // namespace algotest
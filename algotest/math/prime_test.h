@@ -1,20 +1,51 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
+#include "../span.h"
 
 namespace algotest {
 
 class PrimeTesterBase {
-    /// xが素因数かどうかを返す (1 <= x <= 2e18)
+    /// xが素数かどうかを返す (1 <= x <= 2e18)
     virtual bool is_prime(long long x) = 0;
     /// xの素因数の一覧を返す (1 <= x <= 2e18)
     virtual std::vector<long long> factor(long long x) = 0;
 };
 
+/// まとめて投げる版
+class PrimeBatchTesterBase {
+    /// xが素数かどうかを返す (1 <= x <= 2e18)
+    virtual bool is_prime(long long x) = 0;
+    /// xの素因数の一覧を返す (1 <= x <= 2e18)
+    virtual std::vector<long long> factor(long long x) = 0;
+    /// out[i] = (xs[i] が素数なら 1, そうでなければ 0), 各 Span の長さは等しい
+    virtual void is_prime_batch(Span<const uint64_t> xs, Span<uint8_t> out) = 0;
+    /**
+     * xs[i] の素因数 (昇順, 重複あり) を factors[start[i], start[i + 1]) に入れる
+     * |start| = |xs| + 1, factors は空で渡される
+     */
+    virtual void factor_batch(Span<const uint64_t> xs,
+                              std::vector<uint64_t>& factors,
+                              Span<int> start) = 0;
+};
+
+/// 区間の素数の列挙 (区間篩) と素数の個数
+class PrimeSieveTesterBase {
+    /// [l, r) の素数を昇順に返す (0 <= l <= r <= 10^12, r - l <= 10^9)
+    virtual std::vector<long long> primes(long long l, long long r) = 0;
+    /// n 以下の素数の個数 (0 <= n <= 10^12)
+    virtual long long prime_pi(long long n) = 0;
+};
+
 }  // namespace algotest
 
+#include <atomic>
+#include <thread>
 #include "../random.h"
+#include "../shard.h"
 #include "gtest/gtest.h"
+#include "prime.h"
 
 namespace algotest {
 
@@ -78,4 +109,286 @@ REGISTER_TYPED_TEST_CASE_P(PrimeTest,
                            IsPrimeBigTest,
                            PollardBigTest);
 
+template <typename Prime>
+class PrimeBatchTest : public ::testing::Test {};
+
+namespace prime {
+
+/// 入力の種類
+enum Kind { kRandom, kSmooth, kSemiprime, kKindCount };
+
+inline const char* kind_name(int kind) {
+    static const char* names[kKindCount] = {"random", "smooth", "semiprime"};
+    return names[kind];
+}
+
+/// 2e18 以下の kind の値を n 個
+inline std::vector<uint64_t> gen_values(random::Random& gen, int kind, int n) {
+    const uint64_t hi = 2000000000000000000ULL;
+    static const std::vector<uint32_t> ps = primes_upto(1 << 16);
+    std::vector<uint64_t> xs(n);
+    for (auto& x : xs) {
+        if (kind == kRandom) {
+            x = gen.uniform(uint64_t(1), hi);
+        } else if (kind == kSmooth) {
+            x = random_smooth(gen, hi, ps, 1 << 16);
+        } else {
+            x = random_semiprime(gen, hi);
+        }
+    }
+    return xs;
+}
+
+}  // namespace prime
+
+TYPED_TEST_CASE_P(PrimeBatchTest);
+
+/// 1 ~ 10^5 を1回のバッチで投げ, 篩と比べる
+TYPED_TEST_P(PrimeBatchTest, SmallTest) {
+    int n = 100000;
+    std::vector<uint64_t> xs(n);
+    for (int i = 0; i < n; i++)
+        xs[i] = i + 1;
+    auto expect = prime::sieve_segment(1, n + 1, prime::primes_upto(1000));
+    std::vector<uint8_t> out(n, 2);
+    TypeParam your_prime;
+    your_prime.is_prime_batch(xs, out);
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ(int(expect[i]), int(out[i])) << "x = " << xs[i];
+    }
+    std::vector<uint64_t> factors;
+    std::vector<int> start(n + 1, -1);
+    your_prime.factor_batch(xs, factors, start);
+    ASSERT_EQ(0, start[0]);
+    ASSERT_EQ(int(factors.size()), start[n]);
+    for (int i = 0; i < n; i++) {
+        ASSERT_LE(start[i], start[i + 1]) << "i = " << i;
+    }
+    for (int i = 0; i < n; i++) {
+        std::vector<uint64_t> fs(factors.begin() + start[i],
+                                 factors.begin() + start[i + 1]);
+        ASSERT_EQ(prime::factor(xs[i]), fs) << "x = " << xs[i];
+    }
+}
+
+/// ランダム / 2^16-smooth / 同じ大きさの素数2つの積 (<= 2e18) を 10^4 個ずつ
+TYPED_TEST_P(PrimeBatchTest, StressTest) {
+    auto gen = algotest::random::Random();
+    for (int kind = 0; kind < prime::kKindCount; kind++) {
+        int n = 10000;
+        auto xs = prime::gen_values(gen, kind, n);
+        // 素数も混ぜる
+        for (int i = 0; i < n / 10; i++) {
+            xs[gen.uniform(0, n - 1)] =
+                prime::random_prime(gen, 1, 2000000000000000000ULL);
+        }
+        TypeParam your_prime;
+        std::vector<uint8_t> out(n, 2);
+        your_prime.is_prime_batch(xs, out);
+        std::vector<uint64_t> factors;
+        std::vector<int> start(n + 1, -1);
+        your_prime.factor_batch(xs, factors, start);
+        ASSERT_EQ(0, start[0]);
+        ASSERT_EQ(int(factors.size()), start[n]);
+        for (int i = 0; i < n; i++) {
+            ASSERT_LE(start[i], start[i + 1]) << "i = " << i;
+        }
+        for (int i = 0; i < n; i++) {
+            ASSERT_EQ(int(prime::is_prime(xs[i])), int(out[i]))
+                << prime::kind_name(kind) << ", x = " << xs[i];
+            std::vector<uint64_t> fs(factors.begin() + start[i],
+                                     factors.begin() + start[i + 1]);
+            ASSERT_EQ(prime::factor(xs[i]), fs)
+                << prime::kind_name(kind) << ", x = " << xs[i];
+        }
+    }
+}
+
+/**
+ * [1, N] の全ての値の is_prime_batch を区間篩と比べる
+ * 2^20 ずつの窓を ALGOTEST_THREADS 個のスレッドで回す
+ * N は環境変数 ALGOTEST_PRIME_EXHAUSTIVE_N (10^9 ~ 10^10 を想定), なければ何もしない
+ * 候補実装はスレッドごとに作る
+ */
+TYPED_TEST_P(PrimeBatchTest, ExhaustiveTest) {
+    const long long limit = shard::env_int("ALGOTEST_PRIME_EXHAUSTIVE_N", 0);
+    if (limit <= 0)
+        return;
+    const auto ps =
+        prime::primes_upto(uint32_t(std::sqrt(double(limit))) + 1);
+    const long long window = 1 << 20;
+    const long long count = (limit + window - 1) / window;
+    std::atomic<long long> next(0);
+    std::atomic<bool> failed(false);
+    auto worker = [&] {
+        TypeParam your_prime;
+        std::vector<uint64_t> xs;
+        std::vector<uint8_t> out;
+        while (!failed) {
+            long long w = next++;
+            if (w >= count)
+                break;
+            uint64_t lo = 1 + w * window;
+            uint64_t hi = std::min<uint64_t>(lo + window, limit + 1);
+            auto expect = prime::sieve_segment(lo, hi, ps);
+            xs.resize(hi - lo);
+            out.assign(hi - lo, 2);
+            for (uint64_t x = lo; x < hi; x++)
+                xs[x - lo] = x;
+            your_prime.is_prime_batch(xs, out);
+            for (uint64_t x = lo; x < hi; x++) {
+                if (int(expect[x - lo]) != int(out[x - lo])) {
+                    ADD_FAILURE() << "x = " << x << ", expected "
+                                  << int(expect[x - lo]) << ", actual "
+                                  << int(out[x - lo]);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+    };
+    std::vector<std::thread> ths;
+    for (int t = 1; t < shard::thread_count(); t++) {
+        ths.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : ths) {
+        th.join();
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(PrimeBatchTest,
+                           SmallTest,
+                           StressTest,
+                           ExhaustiveTest);
+
+template <typename Prime>
+class PrimeSieveTest : public ::testing::Test {};
+
+namespace prime {
+
+/// [l, r) の素数 (参照実装, r <= 10^12 + 10^9 程度まで)
+inline std::vector<long long> primes_in(long long l, long long r) {
+    static const std::vector<uint32_t> ps = primes_upto(1100000);
+    auto is_p = sieve_segment(uint64_t(l), uint64_t(r), ps);
+    std::vector<long long> res;
+    for (long long x = l; x < r; x++) {
+        if (is_p[x - l])
+            res.push_back(x);
+    }
+    return res;
+}
+
+}  // namespace prime
+
+TYPED_TEST_CASE_P(PrimeSieveTest);
+
+/// 0 <= l <= r <= 10^6 の区間と n <= 10^6 の π(n) を100個ずつ
+TYPED_TEST_P(PrimeSieveTest, SmallTest) {
+    auto gen = algotest::random::Random();
+    auto all = prime::primes_in(0, 1000001);
+    TypeParam your_prime;
+    for (int tc = 0; tc < 100; tc++) {
+        long long l = gen.uniform(0, 1000000);
+        long long r = gen.uniform(0, 1000000);
+        if (l > r)
+            std::swap(l, r);
+        if (tc < 10)
+            r = std::min(r, l + tc);
+        auto lo = std::lower_bound(all.begin(), all.end(), l);
+        auto hi = std::lower_bound(all.begin(), all.end(), r);
+        ASSERT_EQ(std::vector<long long>(lo, hi), your_prime.primes(l, r))
+            << "l = " << l << ", r = " << r;
+        long long n = gen.uniform(0, 1000000);
+        if (tc < 10)
+            n = tc;
+        long long pi = std::upper_bound(all.begin(), all.end(), n) - all.begin();
+        ASSERT_EQ(pi, your_prime.prime_pi(n)) << "n = " << n;
+    }
+}
+
+/// π(10^k) (k <= 12) を既知の値と, 10^12 以下のランダムな n を参照実装と比べる
+TYPED_TEST_P(PrimeSieveTest, PrimePiTest) {
+    const long long table[13] = {0,          4,           25,
+                                 168,        1229,        9592,
+                                 78498,      664579,      5761455,
+                                 50847534,   455052511,   4118054813LL,
+                                 37607912018LL};
+    TypeParam your_prime;
+    long long p10 = 1;
+    for (int k = 0; k <= 12; k++, p10 *= 10) {
+        ASSERT_EQ(table[k], your_prime.prime_pi(p10)) << "n = 10^" << k;
+    }
+    auto gen = algotest::random::Random();
+    for (int tc = 0; tc < 5; tc++) {
+        long long n = gen.uniform(1LL, 1000000000000LL);
+        ASSERT_EQ(prime::prime_pi(n), your_prime.prime_pi(n)) << "n = " << n;
+    }
+}
+
+/// 10^9, 10^10, 10^11, 10^12 で終わる長さ 10^7 の区間を区間篩と比べる
+TYPED_TEST_P(PrimeSieveTest, LargeWindowTest) {
+    TypeParam your_prime;
+    for (long long r = 1000000000; r <= 1000000000000LL; r *= 10) {
+        long long l = r - 10000000;
+        auto expect = prime::primes_in(l, r);
+        auto actual = your_prime.primes(l, r);
+        ASSERT_EQ(expect.size(), actual.size()) << "l = " << l << ", r = " << r;
+        for (size_t i = 0; i < expect.size(); i++) {
+            ASSERT_EQ(expect[i], actual[i]) << "l = " << l << ", r = " << r;
+        }
+        // π とも合っているか
+        ASSERT_EQ((long long)(expect.size()),
+                  your_prime.prime_pi(r - 1) - your_prime.prime_pi(l - 1))
+            << "l = " << l << ", r = " << r;
+    }
+}
+
+/**
+ * [10^12 - 2^28, 10^12) を 2^22 ずつの窓に分け, ALGOTEST_THREADS 個のスレッドから
+ * 別々の候補実装で列挙して区間篩と比べる, 合計の個数を Lucy の π とも比べる
+ */
+TYPED_TEST_P(PrimeSieveTest, ParallelTest) {
+    const long long end = 1000000000000LL;
+    const long long window = 1 << 22, count = 1 << 6;
+    const long long begin = end - window * count;
+    std::atomic<long long> next(0), total(0);
+    std::atomic<bool> failed(false);
+    auto worker = [&] {
+        TypeParam your_prime;
+        while (!failed) {
+            long long w = next++;
+            if (w >= count)
+                break;
+            long long l = begin + w * window, r = l + window;
+            auto expect = prime::primes_in(l, r);
+            auto actual = your_prime.primes(l, r);
+            if (expect != actual) {
+                ADD_FAILURE() << "l = " << l << ", r = " << r << ": "
+                              << expect.size() << " primes expected, "
+                              << actual.size() << " returned";
+                failed = true;
+            }
+            total += (long long)(actual.size());
+        }
+    };
+    std::vector<std::thread> ths;
+    for (int t = 1; t < shard::thread_count(); t++) {
+        ths.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : ths) {
+        th.join();
+    }
+    ASSERT_FALSE(failed);
+    ASSERT_EQ(prime::prime_pi(end - 1) - prime::prime_pi(begin - 1),
+              total.load());
+}
+
+REGISTER_TYPED_TEST_CASE_P(PrimeSieveTest,
+                           SmallTest,
+                           PrimePiTest,
+                           LargeWindowTest,
+                           ParallelTest);
+
 }  // namespace algotest
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ALGOTEST_PERF_EVENT 1
+#endif
+
+/**
+ * ハードウェアカウンタ (perf_event_open) で候補実装の呼び出しを測る
+ * Linux 以外, 権限がない (perf_event_paranoid), 仮想マシンで PMU がない
+ * などで開けないカウンタは ok = false になり, 測定自体は失敗しない
+ * ユーザ空間のみ, 呼び出したスレッドとそこから作られたスレッドを数える
+ */
+namespace algotest {
+
+namespace perf {
+
+enum Event {
+    kCycles,
+    kInstructions,
+    kL1DMisses,
+    kLLCMisses,
+    kBranchMisses,
+    kEventCount
+};
+
+inline const char* event_name(int e) {
+    static const char* names[kEventCount] = {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+    return names[e];
+}
+
+struct Result {
+    /// 多重化で一部の時間しか数えられなかった場合は補正した値
+    double value[kEventCount] = {};
+    bool ok[kEventCount] = {};
+
+    bool any() const {
+        for (int e = 0; e < kEventCount; e++) {
+            if (ok[e])
+                return true;
+        }
+        return false;
+    }
+
+    /// 取れたカウンタについて f(名前, 値) を呼ぶ
+    template <class F>
+    void each(F f) const {
+        for (int e = 0; e < kEventCount; e++) {
+            if (ok[e])
+                f(std::string(event_name(e)), value[e]);
+        }
+    }
+};
+
+/// start() から stop() までを数える, 使い回してよい
+class Probe {
+  public:
+    Probe() {
+        for (int e = 0; e < kEventCount; e++) {
+            fd[e] = open_event(e);
+        }
+    }
+    ~Probe() {
+#ifdef ALGOTEST_PERF_EVENT
+        for (int e = 0; e < kEventCount; e++) {
+            if (fd[e] >= 0)
+                close(fd[e]);
+        }
+#endif
+    }
+    Probe(const Probe&) = delete;
+    Probe& operator=(const Probe&) = delete;
+
+    /// 1つでもカウンタが開けたか
+    bool available() const {
+        for (int e = 0; e < kEventCount; e++) {
+            if (fd[e] >= 0)
+                return true;
+        }
+        return false;
+    }
+
+    void start() {
+#ifdef ALGOTEST_PERF_EVENT
+        for (int e = 0; e < kEventCount; e++) {
+            if (fd[e] < 0)
+                continue;
+            ioctl(fd[e], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    Result stop() {
+        Result r;
+#ifdef ALGOTEST_PERF_EVENT
+        for (int e = 0; e < kEventCount; e++) {
+            if (fd[e] >= 0)
+                ioctl(fd[e], PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (int e = 0; e < kEventCount; e++) {
+            if (fd[e] < 0)
+                continue;
+            // {値, 有効だった時間, 実際に数えた時間}
+            uint64_t buf[3];
+            if (read(fd[e], buf, sizeof(buf)) != ssize_t(sizeof(buf)) ||
+                buf[2] == 0)
+                continue;
+            r.ok[e] = true;
+            r.value[e] = double(buf[0]) * double(buf[1]) / double(buf[2]);
+        }
+#endif
+        return r;
+    }
+
+  private:
+    int fd[kEventCount];
+
+    static int open_event(int e) {
+#ifdef ALGOTEST_PERF_EVENT
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // 測定中に作られたスレッドの分も数える
+        attr.inherit = 1;
+        attr.read_format =
+            PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        switch (e) {
+            case kCycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case kInstructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case kL1DMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case kLLCMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            case kBranchMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+        }
+        return int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)e;
+        return -1;
+#endif
+    }
+};
+
+/// f() の間のカウンタ
+template <class F>
+Result measure(F f) {
+    Probe probe;
+    probe.start();
+    f();
+    return probe.stop();
+}
+
+}  // namespace perf
+
+}  // namespace algotest
@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <numeric>
 #include <random>
+#include <string>
+#include <vector>
 
 namespace algotest {
 
@@ -14,14 +16,16 @@ struct Random {
   private:
     std::mt19937_64 mt;
 
-    // random choice from [0, upper]
-    uint64_t next(uint64_t upper) {
-        if (!(upper & (upper + 1))) {
-            // b = 00..0011..11
-            return mt() & upper;
-        }
+    // smallest 00..0011..11 that >= upper
+    static uint64_t mask_of(uint64_t upper) {
+        if (!(upper & (upper + 1)))
+            return upper;
         int lg = 63 - __builtin_clzll(upper);
-        uint64_t mask = (lg == 63) ? ~0ULL : (1ULL << (lg + 1)) - 1;
+        return (lg == 63) ? ~0ULL : (1ULL << (lg + 1)) - 1;
+    }
+
+    // random choice from [0, upper], mask = mask_of(upper)
+    uint64_t next(uint64_t upper, uint64_t mask) {
         while (true) {
             uint64_t r = mt() & mask;
             if (r <= upper)
@@ -29,8 +33,24 @@ struct Random {
         }
     }
 
+    // random choice from [0, upper]
+    uint64_t next(uint64_t upper) { return next(upper, mask_of(upper)); }
+
   public:
     Random() : mt() {}
+    explicit Random(uint64_t seed) : mt(seed) {}
+    // seedから作る, streamごとに独立な系列
+    Random(uint64_t seed, uint64_t stream) {
+        std::seed_seq seq{uint32_t(seed), uint32_t(seed >> 32),
+                          uint32_t(stream), uint32_t(stream >> 32)};
+        mt.seed(seq);
+    }
+
+    // 自分の系列を進めて, 独立な系列を作る (並列生成用)
+    Random split() {
+        uint64_t seed = mt();
+        return Random(seed, mt());
+    }
 
     // random choice from [lower, upper]
     template <class T>
@@ -46,12 +66,29 @@ struct Random {
         return double(v) / (1ULL << 63);
     }
 
+    // fill [first, last) with uniform(lower, upper)
+    // (same sequence as calling uniform one by one)
+    template <class Iter, class T>
+    void uniform_fill(Iter first, Iter last, T lower, T upper) {
+        assert(lower <= upper);
+        uint64_t range = uint64_t(upper - lower), mask = mask_of(range);
+        for (; first != last; ++first) {
+            *first = T(lower + next(range, mask));
+        }
+    }
+
+    // generate vector that length = n, each element is uniform(lower, upper)
+    template <class T>
+    std::vector<T> uniform_vector(size_t n, T lower, T upper) {
+        std::vector<T> v(n);
+        uniform_fill(v.begin(), v.end(), lower, upper);
+        return v;
+    }
+
     // generate random lower string that length = n
     std::string lower_string(size_t n) {
-        std::string s = "";
-        for (size_t i = 0; i < n; i++) {
-            s += uniform('a', 'z');
-        }
+        std::string s(n, 'a');
+        uniform_fill(s.begin(), s.end(), 'a', 'z');
         return s;
     }
 
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random.h"
+
+/**
+ * ランダムテストのケースを複数スレッドに分けて回す
+ * ケース i の乱数は (suite, i) だけから決まるので, スレッド数によらず同じ入力になる
+ *
+ * 環境変数
+ *   ALGOTEST_THREADS: スレッド数 (デフォルトは 1)
+ *   ALGOTEST_STRESS_SCALE: ケース数を何倍にするか (デフォルトは 1)
+ *   ALGOTEST_CASE: そのケースだけを1スレッドで回す (失敗したケースの再現用)
+ *
+ * 候補実装はケースごとに作ること
+ * ALGOTEST_THREADS >= 2 のときは異なるインスタンスが並行に動くので, 候補実装が
+ * static な領域やグローバル変数を共有していると壊れる (そのときは 1 のまま回す)
+ */
+namespace algotest {
+
+namespace shard {
+
+using algotest::random::Random;
+
+/// 環境変数 name の値, なければ (または数でなければ) def
+inline long long env_int(const char* name, long long def) {
+    const char* s = std::getenv(name);
+    if (!s || !*s)
+        return def;
+    char* end;
+    long long v = std::strtoll(s, &end, 10);
+    return *end ? def : v;
+}
+
+/// 候補実装はスレッドセーフとは限らないので, 指定がなければ 1
+inline int thread_count() {
+    return int(std::max(1LL, env_int("ALGOTEST_THREADS", 1)));
+}
+
+inline int scale() {
+    return int(std::max(1LL, env_int("ALGOTEST_STRESS_SCALE", 1)));
+}
+
+/// 再現するケース番号, なければ -1
+inline long long replay_case() {
+    return env_int("ALGOTEST_CASE", -1);
+}
+
+/// suite のケース index 用の乱数
+inline Random case_random(const std::string& suite, long long index) {
+    // FNV-1a
+    uint64_t h = 14695981039346656037ULL;
+    for (char c : suite) {
+        h = (h ^ uint64_t((unsigned char)(c))) * 1099511628211ULL;
+    }
+    return Random(h, uint64_t(index));
+}
+
+/**
+ * f(gen, index) を index = 0, ..., count * scale() - 1 について並列に呼ぶ
+ * f の中では gtest の ASSERT_* / EXPECT_* が使える, 失敗したら新しいケースは始めない
+ */
+template <class F>
+void run(const std::string& suite, int count, F f) {
+    auto trace = [&](long long index) {
+        return suite + " case " + std::to_string(index) +
+               " (ALGOTEST_CASE=" + std::to_string(index) + " で再現)";
+    };
+    long long replay = replay_case();
+    if (replay >= 0) {
+        Random gen = case_random(suite, replay);
+        SCOPED_TRACE(trace(replay));
+        f(gen, replay);
+        return;
+    }
+    long long total = (long long)(count) * scale();
+    int threads = int(std::min<long long>(thread_count(), total));
+    std::atomic<long long> next(0);
+    std::atomic<bool> failed(false);
+    auto worker = [&] {
+        while (!failed) {
+            long long i = next++;
+            if (i >= total)
+                break;
+            Random gen = case_random(suite, i);
+            {
+                SCOPED_TRACE(trace(i));
+                f(gen, i);
+            }
+            if (::testing::Test::HasFailure())
+                failed = true;
+        }
+    };
+    std::vector<std::thread> ths;
+    for (int t = 1; t < threads; t++) {
+        ths.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : ths) {
+        th.join();
+    }
+}
+
+}  // namespace shard
+
+}  // namespace algotest
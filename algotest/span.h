@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace algotest {
+
+/// 連続領域への参照 (std::span の代わり)
+template <class T>
+struct Span {
+    T* ptr = nullptr;
+    size_t len = 0;
+
+    Span() = default;
+    Span(T* _ptr, size_t _len) : ptr(_ptr), len(_len) {}
+    template <class U>
+    Span(std::vector<U>& v) : ptr(v.data()), len(v.size()) {}
+    template <class U>
+    Span(const std::vector<U>& v) : ptr(v.data()), len(v.size()) {}
+
+    T* data() const { return ptr; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + len; }
+    T& operator[](size_t i) const {
+        assert(i < len);
+        return ptr[i];
+    }
+    Span subspan(size_t offset, size_t count) const {
+        assert(offset + count <= len);
+        return Span(ptr + offset, count);
+    }
+};
+
+}  // namespace algotest
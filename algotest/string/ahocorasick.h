@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <string>
+#include <vector>
+
+// "正しい" Aho-Corasick (英小文字, 遷移は全て埋めた表で持つ)
+namespace algotest {
+
+namespace ahocorasick {
+
+struct Automaton {
+    /// 状態 0 が根 (何も読んでいない)
+    std::vector<std::array<int, 26>> next;
+    std::vector<int> fail;
+    /// head[v]: v で終わるパターンの1つ (なければ -1), 同じ文字列のパターンは same でつなぐ
+    std::vector<int> head, same;
+    /// dict[v]: fail を辿って最初に head != -1 となる真の接尾辞の状態 (なければ -1)
+    std::vector<int> dict;
+    std::vector<int> len;
+    /// 根以外の状態の BFS 順 (fail は必ず前に来る)
+    std::vector<int> order;
+
+    Automaton() = default;
+    explicit Automaton(const std::vector<std::string>& patterns) {
+        build(patterns);
+    }
+
+    int size() const { return int(next.size()); }
+
+    void build(const std::vector<std::string>& patterns) {
+        int m = int(patterns.size());
+        next.assign(1, std::array<int, 26>());
+        next[0].fill(-1);
+        head.assign(1, -1);
+        same.assign(m, -1);
+        len.assign(m, 0);
+        for (int j = 0; j < m; j++) {
+            int v = 0;
+            for (char ch : patterns[j]) {
+                int c = ch - 'a';
+                assert(0 <= c && c < 26);
+                if (next[v][c] < 0) {
+                    next[v][c] = int(next.size());
+                    next.emplace_back();
+                    next.back().fill(-1);
+                    head.push_back(-1);
+                }
+                v = next[v][c];
+            }
+            len[j] = int(patterns[j].size());
+            same[j] = head[v];
+            head[v] = j;
+        }
+        int n = size();
+        fail.assign(n, 0);
+        dict.assign(n, -1);
+        std::vector<int>& que = order;
+        que.clear();
+        que.reserve(n);
+        for (int c = 0; c < 26; c++) {
+            int u = next[0][c];
+            if (u < 0) {
+                next[0][c] = 0;
+            } else {
+                que.push_back(u);
+            }
+        }
+        for (size_t h = 0; h < que.size(); h++) {
+            int v = que[h];
+            int f = fail[v];
+            dict[v] = head[f] != -1 ? f : dict[f];
+            for (int c = 0; c < 26; c++) {
+                int u = next[v][c];
+                if (u < 0) {
+                    next[v][c] = next[f][c];
+                } else {
+                    fail[u] = next[f][c];
+                    que.push_back(u);
+                }
+            }
+        }
+    }
+
+    int step(int v, char ch) const { return next[v][ch - 'a']; }
+
+    /// 状態 v で終わる全てのパターン j について f(j)
+    template <class F>
+    void each_match(int v, F f) const {
+        if (head[v] == -1)
+            v = dict[v];
+        for (; v > 0; v = dict[v]) {
+            for (int j = head[v]; j != -1; j = same[j])
+                f(j);
+        }
+    }
+
+    /// 各パターンの s での出現回数, 状態ごとに数えて fail を逆に辿って足す
+    std::vector<long long> count(const std::string& s) const {
+        std::vector<long long> cnt(size());
+        int v = 0;
+        for (char ch : s) {
+            v = step(v, ch);
+            cnt[v]++;
+        }
+        for (size_t i = order.size(); i-- > 0;) {
+            int u = order[i];
+            cnt[fail[u]] += cnt[u];
+        }
+        std::vector<long long> res(len.size());
+        for (int u = 1; u < size(); u++) {
+            for (int j = head[u]; j != -1; j = same[j])
+                res[j] = cnt[u];
+        }
+        return res;
+    }
+
+    /// 各パターンの s での最初の出現位置 (先頭), なければ -1
+    std::vector<int> first_match(const std::string& s) const {
+        const int inf = int(s.size()) + 1;
+        // 状態ごとに最初に到達した位置 (終端の次)
+        std::vector<int> first(size(), inf);
+        int v = 0;
+        for (int i = 0; i < int(s.size()); i++) {
+            v = step(v, s[i]);
+            if (first[v] == inf)
+                first[v] = i + 1;
+        }
+        for (size_t i = order.size(); i-- > 0;) {
+            int u = order[i];
+            first[fail[u]] = std::min(first[fail[u]], first[u]);
+        }
+        std::vector<int> res(len.size(), -1);
+        for (int u = 1; u < size(); u++) {
+            if (first[u] == inf)
+                continue;
+            for (int j = head[u]; j != -1; j = same[j])
+                res[j] = first[u] - len[j];
+        }
+        return res;
+    }
+
+    /**
+     * 状態 v から s[0, n) を読み, 読み終わった状態を返す
+     * s[0] のストリーム全体での位置を offset として, 出現するたび f(パターン, 開始位置)
+     */
+    template <class F>
+    int feed(int v, const char* s, size_t n, long long offset, F f) const {
+        for (size_t i = 0; i < n; i++) {
+            v = step(v, s[i]);
+            long long end = offset + (long long)(i) + 1;
+            each_match(v, [&](int j) { f(j, end - len[j]); });
+        }
+        return v;
+    }
+};
+
+}  // namespace ahocorasick
+
+}  // namespace algotest
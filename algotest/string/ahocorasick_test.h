@@ -1,9 +1,11 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <numeric>
 #include <string>
 #include <vector>
+#include "../span.h"
 
 namespace algotest {
 
@@ -19,9 +21,42 @@ class AhoCorasickTesterBase {
         std::vector<std::string> patterns) = 0;
 };
 
+/// 長い文字列を少しずつ流し込む版
+class AhoCorasickStreamTesterBase {
+    /// 最初に1回, パターンは英小文字で空でない (同じものが複数あってもよい)
+    virtual void setup(std::vector<std::string> patterns) = 0;
+    /// 何も読んでいない状態
+    virtual int initial_state() = 0;
+    /**
+     * 状態 state から chunk (英小文字, 空のこともある) を読み, 読み終わった状態を返す
+     * offset はストリーム全体での chunk[0] の位置
+     * patterns[j] が位置 p から始まる出現を読み終えるたび on_match(j, p) を呼ぶ
+     * (前の chunk から続く出現では p < offset になる, 呼ぶ順は問わない)
+     * 状態は返り値だけで表すこと, 複数のストリームを交互に読むことがある
+     */
+    virtual int feed(int state,
+                     Span<const char> chunk,
+                     long long offset,
+                     const std::function<void(int, long long)>& on_match) = 0;
+};
+
+/// 10^5 ~ 10^6 個の大きな辞書向け, 出現を列挙せずに数える / 最初の出現だけ返す版
+class AhoCorasickCountTesterBase {
+    /// 最初に1回, パターンは英小文字で空でない (同じものが複数あってもよい)
+    virtual void setup(std::vector<std::string> patterns) = 0;
+    /// 長さ|patterns|, 各パターンの target (英小文字) 中の出現回数
+    virtual std::vector<long long> count(const std::string& target) = 0;
+    /// 長さ|patterns|, 各パターンの target 中の最初の出現位置 (先頭), なければ -1
+    virtual std::vector<int> first_match(const std::string& target) = 0;
+    // (任意) 使っているバイト数, あればベンチマークがノードあたりのバイト数を出す
+    // size_t memory_bytes();
+};
+
 }  // namespace algotest
 
 #include "../random.h"
+#include "../shard.h"
+#include "ahocorasick.h"
 #include "gtest/gtest.h"
 
 namespace algotest {
@@ -31,11 +66,11 @@ class AhoCorasickTest : public ::testing::Test {};
 
 TYPED_TEST_CASE_P(AhoCorasickTest);
 
+/// 300ケース, 複数スレッドで回す (shard.h)
 TYPED_TEST_P(AhoCorasickTest, StressTest) {
-    TypeParam your_ahocorasick;
-    auto gen = algotest::random::Random();
-
-    for (int i = 0; i < 300; i++) {
+    shard::run("AhoCorasickTest.StressTest", 300, [](random::Random& gen,
+                                                     long long) {
+        TypeParam your_ahocorasick;
         int n = gen.uniform(1, 100);
         int m = gen.uniform(1, 20);
         std::string target = gen.lower_string(n);
@@ -60,7 +95,7 @@ TYPED_TEST_P(AhoCorasickTest, StressTest) {
             }
             ASSERT_EQ(v, res[j]);
         }
-    }
+    });
 }
 
 TYPED_TEST_P(AhoCorasickTest, SkipFailureLinkTest) {
@@ -82,4 +117,331 @@ TYPED_TEST_P(AhoCorasickTest, SkipFailureLinkTest) {
 
 REGISTER_TYPED_TEST_CASE_P(AhoCorasickTest, StressTest, SkipFailureLinkTest);
 
+template <typename AC>
+class AhoCorasickStreamTest : public ::testing::Test {};
+
+namespace ahocorasick {
+
+/// ストリームを区切りごとに流し込み, パターンごとの出現位置 (昇順) を返す
+template <class AC>
+std::vector<std::vector<long long>> feed_chunks(AC& ac,
+                                                int m,
+                                                const std::string& target,
+                                                const std::vector<int>& cuts) {
+    std::vector<std::vector<long long>> res(m);
+    int state = ac.initial_state();
+    for (size_t i = 0; i + 1 < cuts.size(); i++) {
+        Span<const char> chunk(target.data() + cuts[i], cuts[i + 1] - cuts[i]);
+        state = ac.feed(state, chunk, cuts[i],
+                        [&](int j, long long p) { res[j].push_back(p); });
+    }
+    for (auto& v : res) {
+        std::sort(v.begin(), v.end());
+    }
+    return res;
+}
+
+/// [0, n] をランダムに区切る (長さ 0 の区間も出る), 先頭 0, 末尾 n
+inline std::vector<int> random_cuts(random::Random& gen, int n) {
+    int k = gen.uniform(0, std::min(n, 20));
+    std::vector<int> cuts = gen.uniform_vector(k, 0, n);
+    cuts.push_back(0);
+    cuts.push_back(n);
+    std::sort(cuts.begin(), cuts.end());
+    return cuts;
+}
+
+/// 参照実装で全体を一度に読んだときの出現位置
+inline std::vector<std::vector<long long>> expected_matches(
+    const std::vector<std::string>& patterns,
+    const std::string& target) {
+    Automaton ac(patterns);
+    std::vector<std::vector<long long>> res(patterns.size());
+    ac.feed(0, target.data(), target.size(), 0,
+            [&](int j, long long p) { res[j].push_back(p); });
+    for (auto& v : res) {
+        std::sort(v.begin(), v.end());
+    }
+    return res;
+}
+
+}  // namespace ahocorasick
+
+TYPED_TEST_CASE_P(AhoCorasickStreamTest);
+
+/// 300ケース, ランダムに区切って流し込み愚直解と比べる (2本のストリームを交互に)
+TYPED_TEST_P(AhoCorasickStreamTest, StressTest) {
+    shard::run("AhoCorasickStreamTest.StressTest", 300, [](random::Random& gen,
+                                                           long long) {
+        int n = gen.uniform(1, 100);
+        int m = gen.uniform(1, 20);
+        std::string target = gen.lower_string(n);
+        // 短いパターンが当たるように文字の種類を絞ることがある
+        if (gen.uniform_bool()) {
+            for (auto& c : target)
+                c = char('a' + gen.uniform(0, 1));
+        }
+        std::vector<std::string> patterns(m);
+        for (int j = 0; j < m; j++) {
+            if (j > 0 && gen.uniform(0, 9) == 0) {
+                patterns[j] = patterns[gen.uniform(0, j - 1)];
+            } else if (gen.uniform(0, 2) == 0) {
+                patterns[j] = gen.lower_string(gen.uniform(1, 10));
+            } else {
+                int di = gen.uniform(1, n);
+                int st = gen.uniform(0, n - di);
+                patterns[j] = target.substr(st, di);
+            }
+        }
+        std::vector<std::vector<long long>> expect(m);
+        for (int j = 0; j < m; j++) {
+            int di = int(patterns[j].size());
+            for (int st = 0; st + di <= n; st++) {
+                if (target.compare(st, di, patterns[j]) == 0)
+                    expect[j].push_back(st);
+            }
+        }
+
+        TypeParam your_ahocorasick;
+        your_ahocorasick.setup(patterns);
+        // 2本目は逆順の文字列, 区切りを交互に流し込む
+        std::string target2(target.rbegin(), target.rend());
+        auto cuts = ahocorasick::random_cuts(gen, n);
+        auto cuts2 = ahocorasick::random_cuts(gen, n);
+        std::vector<std::vector<long long>> res(m), res2(m);
+        int st = your_ahocorasick.initial_state();
+        int st2 = your_ahocorasick.initial_state();
+        for (size_t i = 0; i + 1 < std::max(cuts.size(), cuts2.size()); i++) {
+            if (i + 1 < cuts.size()) {
+                Span<const char> chunk(target.data() + cuts[i],
+                                       cuts[i + 1] - cuts[i]);
+                st = your_ahocorasick.feed(
+                    st, chunk, cuts[i],
+                    [&](int j, long long p) { res[j].push_back(p); });
+            }
+            if (i + 1 < cuts2.size()) {
+                Span<const char> chunk(target2.data() + cuts2[i],
+                                       cuts2[i + 1] - cuts2[i]);
+                st2 = your_ahocorasick.feed(
+                    st2, chunk, cuts2[i],
+                    [&](int j, long long p) { res2[j].push_back(p); });
+            }
+        }
+        auto expect2 = ahocorasick::expected_matches(patterns, target2);
+        for (int j = 0; j < m; j++) {
+            std::sort(res[j].begin(), res[j].end());
+            std::sort(res2[j].begin(), res2[j].end());
+            ASSERT_EQ(expect[j], res[j]) << "pattern " << j;
+            ASSERT_EQ(expect2[j], res2[j]) << "pattern " << j << " (reversed)";
+        }
+    });
+}
+
+/**
+ * 区切りを 1 ~ 16 文字ごとに固定し, ほとんどの出現が区切りをまたぐようにする
+ * 文字列は "a" の繰り返しと周期的な文字列
+ */
+TYPED_TEST_P(AhoCorasickStreamTest, BoundaryTest) {
+    auto gen = algotest::random::Random();
+    std::vector<std::string> targets = {std::string(10000, 'a'),
+                                        std::string(10000, 'a')};
+    for (int i = 0; i < 10000; i++) {
+        targets[1][i] = "abaabc"[i % 6];
+    }
+    for (const auto& target : targets) {
+        std::vector<std::string> patterns;
+        for (int k = 1; k <= 20; k++) {
+            patterns.push_back(std::string(k, 'a'));
+        }
+        for (int k = 0; k < 20; k++) {
+            int di = gen.uniform(1, 40);
+            patterns.push_back(target.substr(gen.uniform(0, 9999 - di), di));
+        }
+        auto expect = ahocorasick::expected_matches(patterns, target);
+        int n = int(target.size());
+        for (int c = 1; c <= 16; c++) {
+            std::vector<int> cuts;
+            for (int i = 0; i < n; i += c)
+                cuts.push_back(i);
+            cuts.push_back(n);
+            TypeParam your_ahocorasick;
+            your_ahocorasick.setup(patterns);
+            auto res = ahocorasick::feed_chunks(
+                your_ahocorasick, int(patterns.size()), target, cuts);
+            for (size_t j = 0; j < patterns.size(); j++) {
+                ASSERT_EQ(expect[j], res[j])
+                    << "chunk size " << c << ", pattern " << patterns[j];
+            }
+        }
+    }
+}
+
+/**
+ * 2^28 文字を 1 ~ 2^17 文字ずつ作りながら流し込む (全体は持たない)
+ * パターンは "abcd" からなる長さ 6 ~ 16 のもの 1000 個
+ * 出現の個数と位置の和をパターンごとに参照実装と比べる
+ */
+TYPED_TEST_P(AhoCorasickStreamTest, LargeTest) {
+    auto gen = algotest::random::Random();
+    const long long total = 1LL << 28;
+    int m = 1000;
+    std::vector<std::string> patterns(m);
+    for (auto& p : patterns) {
+        p.resize(gen.uniform(6, 16));
+        for (auto& c : p)
+            c = char('a' + gen.uniform(0, 3));
+    }
+    ahocorasick::Automaton ac(patterns);
+    TypeParam your_ahocorasick;
+    your_ahocorasick.setup(patterns);
+
+    std::vector<long long> count(m), your_count(m);
+    std::vector<unsigned long long> pos_sum(m), your_pos_sum(m);
+    std::string chunk;
+    int state = 0, your_state = your_ahocorasick.initial_state();
+    for (long long offset = 0; offset < total;) {
+        int len = int(std::min<long long>(gen.uniform(1, 1 << 17),
+                                          total - offset));
+        chunk.resize(len);
+        for (auto& c : chunk)
+            c = char('a' + gen.uniform(0, 3));
+        state = ac.feed(state, chunk.data(), len, offset,
+                        [&](int j, long long p) {
+                            count[j]++;
+                            pos_sum[j] += (unsigned long long)(p);
+                        });
+        your_state = your_ahocorasick.feed(
+            your_state, Span<const char>(chunk.data(), len), offset,
+            [&](int j, long long p) {
+                your_count[j]++;
+                your_pos_sum[j] += (unsigned long long)(p);
+            });
+        offset += len;
+    }
+    for (int j = 0; j < m; j++) {
+        ASSERT_EQ(count[j], your_count[j]) << "pattern " << patterns[j];
+        ASSERT_EQ(pos_sum[j], your_pos_sum[j]) << "pattern " << patterns[j];
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(AhoCorasickStreamTest,
+                           StressTest,
+                           BoundaryTest,
+                           LargeTest);
+
+template <typename AC>
+class AhoCorasickCountTest : public ::testing::Test {};
+
+namespace ahocorasick {
+
+/**
+ * 長さ 4 ~ max_len のパターン m 個, 半分は target の部分文字列, 1 / 100 は重複
+ * 残りはランダム (ほとんど出現しない)
+ */
+inline std::vector<std::string> gen_dictionary(random::Random& gen,
+                                               const std::string& target,
+                                               int m,
+                                               int max_len) {
+    int n = int(target.size());
+    std::vector<std::string> patterns(m);
+    for (int j = 0; j < m; j++) {
+        int len = gen.uniform(4, max_len);
+        if (j > 0 && gen.uniform(0, 99) == 0) {
+            patterns[j] = patterns[gen.uniform(0, j - 1)];
+        } else if (gen.uniform_bool() && len <= n) {
+            patterns[j] = target.substr(gen.uniform(0, n - len), len);
+        } else {
+            patterns[j] = gen.lower_string(len);
+        }
+    }
+    return patterns;
+}
+
+}  // namespace ahocorasick
+
+TYPED_TEST_CASE_P(AhoCorasickCountTest);
+
+/// 300ケース, 愚直解と比べる
+TYPED_TEST_P(AhoCorasickCountTest, StressTest) {
+    shard::run("AhoCorasickCountTest.StressTest", 300, [](random::Random& gen,
+                                                          long long) {
+        int n = gen.uniform(1, 100);
+        int m = gen.uniform(1, 20);
+        std::string target = gen.lower_string(n);
+        if (gen.uniform_bool()) {
+            for (auto& c : target)
+                c = char('a' + gen.uniform(0, 1));
+        }
+        std::vector<std::string> patterns(m);
+        for (int j = 0; j < m; j++) {
+            if (j > 0 && gen.uniform(0, 9) == 0) {
+                patterns[j] = patterns[gen.uniform(0, j - 1)];
+            } else if (gen.uniform(0, 2) == 0) {
+                patterns[j] = gen.lower_string(gen.uniform(1, 10));
+            } else {
+                int di = gen.uniform(1, n);
+                patterns[j] = target.substr(gen.uniform(0, n - di), di);
+            }
+        }
+        TypeParam your_ahocorasick;
+        your_ahocorasick.setup(patterns);
+        auto cnt = your_ahocorasick.count(target);
+        auto first = your_ahocorasick.first_match(target);
+        ASSERT_EQ(size_t(m), cnt.size());
+        ASSERT_EQ(size_t(m), first.size());
+        for (int j = 0; j < m; j++) {
+            long long c = 0;
+            int f = -1;
+            int di = int(patterns[j].size());
+            for (int st = n - di; st >= 0; st--) {
+                if (target.compare(st, di, patterns[j]) == 0) {
+                    c++;
+                    f = st;
+                }
+            }
+            ASSERT_EQ(c, cnt[j]) << "pattern " << patterns[j];
+            ASSERT_EQ(f, first[j]) << "pattern " << patterns[j];
+        }
+    });
+}
+
+/**
+ * |target| = 10^7 に対し, 10^5 個 (長さ 4 ~ 16), 10^6 個 (長さ 4 ~ 10) の辞書
+ * 参照実装 (ahocorasick::Automaton) と比べる
+ */
+TYPED_TEST_P(AhoCorasickCountTest, LargeTest) {
+    auto gen = algotest::random::Random();
+    int n = 10000000;
+    // 出現が多くなるよう文字は 'a' ~ 'h' に偏らせる
+    std::string target(n, 'a');
+    for (auto& c : target)
+        c = char('a' + gen.uniform(0, 7));
+    std::vector<std::pair<int, int>> tiers = {{100000, 16}, {1000000, 10}};
+    for (auto tier : tiers) {
+        auto patterns =
+            ahocorasick::gen_dictionary(gen, target, tier.first, tier.second);
+        std::vector<long long> cnt;
+        std::vector<int> first;
+        {
+            ahocorasick::Automaton ac(patterns);
+            cnt = ac.count(target);
+            first = ac.first_match(target);
+        }
+        TypeParam your_ahocorasick;
+        your_ahocorasick.setup(patterns);
+        auto your_cnt = your_ahocorasick.count(target);
+        auto your_first = your_ahocorasick.first_match(target);
+        ASSERT_EQ(cnt.size(), your_cnt.size());
+        ASSERT_EQ(first.size(), your_first.size());
+        for (int j = 0; j < tier.first; j++) {
+            ASSERT_EQ(cnt[j], your_cnt[j])
+                << "m = " << tier.first << ", pattern " << patterns[j];
+            ASSERT_EQ(first[j], your_first[j])
+                << "m = " << tier.first << ", pattern " << patterns[j];
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(AhoCorasickCountTest, StressTest, LargeTest);
+
 }  // namespace algotest
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "../span.h"
+
+// "正しい" Suffix Array (SA-IS, O(n)) と LCP (Kasai, O(n))
+namespace algotest {
+
+namespace suffixarray {
+
+/// s (0 <= s[i] < upper) の SA, 空接尾辞は含まない
+inline std::vector<int> sa_is(const std::vector<int>& s, int upper) {
+    int n = int(s.size());
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? std::vector<int>{0, 1} : std::vector<int>{1, 0};
+    std::vector<int> sa(n);
+    // ls[i]: s[i..] < s[i+1..] (S 型)
+    std::vector<char> ls(n);
+    for (int i = n - 2; i >= 0; i--) {
+        ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
+    }
+    // 文字 c の L 型の先頭 sum_l[c], S 型の先頭 sum_s[c]
+    std::vector<int> sum_l(upper + 1), sum_s(upper + 1);
+    for (int i = 0; i < n; i++) {
+        if (!ls[i])
+            sum_s[s[i]]++;
+        else
+            sum_l[s[i] + 1]++;
+    }
+    for (int i = 0; i <= upper; i++) {
+        sum_s[i] += sum_l[i];
+        if (i < upper)
+            sum_l[i + 1] += sum_s[i];
+    }
+
+    // LMS の位置から誘導ソートする
+    auto induce = [&](const std::vector<int>& lms) {
+        std::fill(sa.begin(), sa.end(), -1);
+        std::vector<int> buf(upper + 1);
+        std::copy(sum_s.begin(), sum_s.end(), buf.begin());
+        for (int d : lms) {
+            if (d == n)
+                continue;
+            sa[buf[s[d]]++] = d;
+        }
+        std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+        sa[buf[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; i++) {
+            int v = sa[i];
+            if (v >= 1 && !ls[v - 1])
+                sa[buf[s[v - 1]]++] = v - 1;
+        }
+        std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+        for (int i = n - 1; i >= 0; i--) {
+            int v = sa[i];
+            if (v >= 1 && ls[v - 1])
+                sa[--buf[s[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    // lms_map[i]: i が LMS なら何番目か, そうでなければ -1
+    std::vector<int> lms_map(n + 1, -1), lms;
+    int m = 0;
+    for (int i = 1; i < n; i++) {
+        if (!ls[i - 1] && ls[i])
+            lms_map[i] = m++;
+    }
+    lms.reserve(m);
+    for (int i = 1; i < n; i++) {
+        if (!ls[i - 1] && ls[i])
+            lms.push_back(i);
+    }
+    induce(lms);
+
+    if (m) {
+        std::vector<int> sorted_lms;
+        sorted_lms.reserve(m);
+        for (int v : sa) {
+            if (lms_map[v] != -1)
+                sorted_lms.push_back(v);
+        }
+        // LMS 部分文字列に番号を振って縮約した文字列を再帰的にソートする
+        std::vector<int> rec_s(m);
+        int rec_upper = 0;
+        rec_s[lms_map[sorted_lms[0]]] = 0;
+        for (int i = 1; i < m; i++) {
+            int l = sorted_lms[i - 1], r = sorted_lms[i];
+            int end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+            int end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+            bool same = true;
+            if (end_l - l != end_r - r) {
+                same = false;
+            } else {
+                while (l < end_l) {
+                    if (s[l] != s[r])
+                        break;
+                    l++;
+                    r++;
+                }
+                if (l == n || s[l] != s[r])
+                    same = false;
+            }
+            if (!same)
+                rec_upper++;
+            rec_s[lms_map[sorted_lms[i]]] = rec_upper;
+        }
+        auto rec_sa = sa_is(rec_s, rec_upper);
+        for (int i = 0; i < m; i++) {
+            sorted_lms[i] = lms[rec_sa[i]];
+        }
+        induce(sorted_lms);
+    }
+    return sa;
+}
+
+/// SuffixArrayTesterBase と同じ形式の SA (先頭に空接尾辞 n を含む, 長さ n + 1)
+inline std::vector<int> suffix_array(const std::string& s) {
+    std::vector<int> s2(s.size());
+    for (size_t i = 0; i < s.size(); i++) {
+        s2[i] = (unsigned char)(s[i]);
+    }
+    std::vector<int> sa = sa_is(s2, 255);
+    sa.insert(sa.begin(), int(s.size()));
+    return sa;
+}
+
+/// lcp[i] = s[sa[i]..] と s[sa[i + 1]..] の LCP (長さ n), sa は suffix_array の形式
+inline std::vector<int> lcp_array(const std::string& s, Span<const int> sa) {
+    int n = int(s.size());
+    std::vector<int> rnk(n + 1), lcp(n);
+    for (int i = 0; i <= n; i++) {
+        rnk[sa[i]] = i;
+    }
+    int h = 0;
+    for (int i = 0; i < n; i++) {
+        if (h > 0)
+            h--;
+        // rnk[i] >= 1 (空接尾辞が先頭)
+        int j = sa[rnk[i] - 1];
+        while (i + h < n && j + h < n && s[i + h] == s[j + h])
+            h++;
+        lcp[rnk[i] - 1] = h;
+    }
+    return lcp;
+}
+
+}  // namespace suffixarray
+
+}  // namespace algotest
@@ -4,6 +4,7 @@
 #include <numeric>
 #include <string>
 #include <vector>
+#include "../span.h"
 
 namespace algotest {
 
@@ -11,12 +12,25 @@ class SuffixArrayTesterBase {
     /// sのSuffixArrayを返す, sは英小文字
     virtual std::vector<int> sa(std::string s) = 0;
     virtual std::vector<int> lcp(std::string s, std::vector<int> sa) = 0;
+    // (任意) 使っているバイト数, あれば SuffixArrayMemoryTest が記録する
+    // size_t memory_bytes();
+};
+
+/// 入力をコピーせずに受け取る版
+class SuffixArrayViewTesterBase {
+    /// sのSuffixArrayを返す, sは英小文字
+    virtual std::vector<int> sa(const std::string& s) = 0;
+    virtual std::vector<int> lcp(const std::string& s, Span<const int> sa) = 0;
 };
 
 }  // namespace algotest
 
+#include "../corpus.h"
+#include "../footprint.h"
 #include "../random.h"
+#include "../shard.h"
 #include "gtest/gtest.h"
+#include "suffixarray.h"
 
 namespace algotest {
 
@@ -25,7 +39,7 @@ class SuffixArrayTest : public ::testing::Test {};
 
 TYPED_TEST_CASE_P(SuffixArrayTest);
 
-std::vector<int> naive_sa(std::string s) {
+inline std::vector<int> naive_sa(std::string s) {
     std::vector<int> idx(s.size() + 1);
     std::iota(idx.begin(), idx.end(), 0);
     std::sort(idx.begin(), idx.end(),
@@ -33,7 +47,7 @@ std::vector<int> naive_sa(std::string s) {
     return idx;
 }
 
-std::vector<int> naive_lcp(std::string s, std::vector<int> sa) {
+inline std::vector<int> naive_lcp(std::string s, std::vector<int> sa) {
     int n = int(s.size());
     std::vector<int> lcp(n);
     for (int i = 0; i < n; i++) {
@@ -55,7 +69,7 @@ TYPED_TEST_P(SuffixArrayTest, SAStressTest) {
         int n = gen.uniform(1, 100);
         std::string s = gen.lower_string(n);
         auto sa1 = your_sa.sa(s);
-        auto sa2 = naive_sa(s);
+        auto sa2 = suffixarray::suffix_array(s);
         ASSERT_EQ(sa1, sa2);
     }
 }
@@ -67,13 +81,201 @@ TYPED_TEST_P(SuffixArrayTest, LCPStressTest) {
     for (int i = 0; i < 100; i++) {
         int n = gen.uniform(1, 100);
         std::string s = gen.lower_string(n);
-        auto sa = naive_sa(s);
+        auto sa = suffixarray::suffix_array(s);
         auto lcp1 = your_sa.lcp(s, sa);
-        auto lcp2 = naive_lcp(s, sa);
+        auto lcp2 = suffixarray::lcp_array(s, sa);
         ASSERT_EQ(lcp1, lcp2);
     }
 }
 
-REGISTER_TYPED_TEST_CASE_P(SuffixArrayTest, SAStressTest, LCPStressTest);
+/**
+ * 長さ 1 ~ 60, 1 ~ 3 種類の文字の短い文字列で, 参照実装 (SA-IS, Kasai) と
+ * 候補実装を愚直な SA, LCP と比べる
+ */
+TYPED_TEST_P(SuffixArrayTest, SmallAlphabetTest) {
+    auto gen = algotest::random::Random();
+    for (int ph = 0; ph < 3000; ph++) {
+        int n = gen.uniform(1, 60);
+        int k = gen.uniform(1, 3);
+        std::string s(n, 'a');
+        for (auto& c : s) {
+            c = char('a' + gen.uniform(0, k - 1));
+        }
+        auto sa = naive_sa(s);
+        auto lcp = naive_lcp(s, sa);
+        ASSERT_EQ(sa, suffixarray::suffix_array(s)) << "reference, s = " << s;
+        ASSERT_EQ(lcp, suffixarray::lcp_array(s, sa)) << "reference, s = " << s;
+        TypeParam your_sa;
+        ASSERT_EQ(sa, your_sa.sa(s)) << "s = " << s;
+        ASSERT_EQ(lcp, your_sa.lcp(s, sa)) << "s = " << s;
+    }
+}
+
+namespace suffixarray {
+
+/// 大きいテストで回す長さの上限, 10^8 まで回すなら ALGOTEST_SA_MAX_N=100000000
+inline long long max_n() {
+    return shard::env_int("ALGOTEST_SA_MAX_N", 10000000);
+}
+
+/// 同じ文字だけ
+inline std::string gen_run(int n) {
+    return std::string(n, 'a');
+}
+
+/// Fibonacci 文字列 (F_1 = "b", F_2 = "a", F_k = F_{k-1} F_{k-2}) の先頭 n 文字
+inline std::string gen_fibonacci(int n) {
+    std::string a = "a", b = "b";
+    while (int(a.size()) < n) {
+        std::string c = a + b;
+        b.swap(a);
+        a.swap(c);
+    }
+    return a.substr(0, n);
+}
+
+/// "acgt" からなる長さ period の塊の繰り返し, 1 / 10^5 の確率で1文字変える
+inline std::string gen_periodic_dna(int n, int period, random::Random& gen) {
+    const char* acgt = "acgt";
+    std::string unit(period, 'a');
+    for (auto& c : unit) {
+        c = acgt[gen.uniform(0, 3)];
+    }
+    std::string s(n, 'a');
+    for (int i = 0; i < n; i++) {
+        s[i] = unit[i % period];
+        if (gen.uniform(0, 99999) == 0)
+            s[i] = acgt[gen.uniform(0, 3)];
+    }
+    return s;
+}
+
+/**
+ * 大きいテストのケース: (名前, corpus) を n <= max_n() について返す
+ * corpus は文字列 "text" と SA-IS, Kasai の答え "sa", "lcp" を持ち,
+ * ALGOTEST_CORPUS_DIR があればキャッシュする
+ * f の中で致命的な失敗が起きたら, 残りのケースは作らずに止める
+ */
+template <class F>
+void each_large_case(F f) {
+    const char* kinds[] = {"random", "run", "fibonacci", "dna_period_1000",
+                           "dna_period_3"};
+    const uint64_t seed = std::mt19937_64::default_seed;
+    for (int n = 1000000; n <= 100000000 && n <= max_n(); n *= 10) {
+        for (int k = 0; k < 5; k++) {
+            std::string name = std::string(kinds[k]) + "_" + std::to_string(n);
+            auto build = [&](corpus::Writer& w) {
+                // ケースごとに独立な系列 (キャッシュの有無で変わらないように)
+                random::Random gen(seed, uint64_t(n) * 5 + k);
+                std::string s;
+                if (k == 0)
+                    s = gen.lower_string(n);
+                else if (k == 1)
+                    s = gen_run(n);
+                else if (k == 2)
+                    s = gen_fibonacci(n);
+                else
+                    s = gen_periodic_dna(n, k == 3 ? 1000 : 3, gen);
+                auto sa = suffix_array(s);
+                w.put("text", s);
+                w.put("sa", sa);
+                w.put("lcp", lcp_array(s, sa));
+            };
+            f(name, corpus::load_or_build(
+                        corpus::Key{std::string("suffixarray_large_") +
+                                        kinds[k],
+                                    {n},
+                                    seed},
+                        build));
+            if (::testing::Test::HasFatalFailure())
+                return;
+        }
+    }
+}
+
+}  // namespace suffixarray
+
+/// 長さ 10^6, 10^7 (ALGOTEST_SA_MAX_N まで) の偏った文字列で SA-IS と比べる
+TYPED_TEST_P(SuffixArrayTest, SALargeTest) {
+    suffixarray::each_large_case([](const std::string& key,
+                                    const corpus::Corpus& c) {
+        auto expect = c.get<int>("sa");
+        TypeParam your_sa;
+        auto actual = your_sa.sa(c.get_string("text"));
+        ASSERT_EQ(expect.size(), actual.size()) << key;
+        for (size_t i = 0; i < expect.size(); i++) {
+            ASSERT_EQ(expect[i], actual[i]) << key << ", i = " << i;
+        }
+    });
+}
+
+/// SALargeTest と同じ文字列で Kasai と比べる
+TYPED_TEST_P(SuffixArrayTest, LCPLargeTest) {
+    suffixarray::each_large_case([](const std::string& key,
+                                    const corpus::Corpus& c) {
+        auto expect = c.get<int>("lcp");
+        TypeParam your_sa;
+        auto actual =
+            your_sa.lcp(c.get_string("text"), c.get_vector<int>("sa"));
+        ASSERT_EQ(expect.size(), actual.size()) << key;
+        for (size_t i = 0; i < expect.size(); i++) {
+            ASSERT_EQ(expect[i], actual[i]) << key << ", i = " << i;
+        }
+    });
+}
+
+REGISTER_TYPED_TEST_CASE_P(SuffixArrayTest,
+                           SAStressTest,
+                           LCPStressTest,
+                           SmallAlphabetTest,
+                           SALargeTest,
+                           LCPLargeTest);
+
+template <typename SA>
+class SuffixArrayViewTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(SuffixArrayViewTest);
+
+/// SuffixArrayTest と同じケース
+TYPED_TEST_P(SuffixArrayViewTest, StressTest) {
+    TypeParam your_sa;
+    auto gen = algotest::random::Random();
+
+    for (int i = 0; i < 100; i++) {
+        int n = gen.uniform(1, 100);
+        std::string s = gen.lower_string(n);
+        auto sa = suffixarray::suffix_array(s);
+        ASSERT_EQ(sa, your_sa.sa(s));
+        auto lcp1 = your_sa.lcp(s, sa);
+        auto lcp2 = suffixarray::lcp_array(s, sa);
+        ASSERT_EQ(lcp2, lcp1);
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(SuffixArrayViewTest, StressTest);
+
+template <typename SA>
+class SuffixArrayMemoryTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(SuffixArrayMemoryTest);
+
+/**
+ * n = 10^6, 10^7, 10^8 (footprint::max_n() まで) の英小文字列で sa() を呼び,
+ * 返り値を含むメモリと, 呼び出し中のピークを記録する
+ */
+TYPED_TEST_P(SuffixArrayMemoryTest, FootprintTest) {
+    auto gen = algotest::random::Random();
+    for (int n = 1000000; n <= 100000000 && n <= footprint::max_n();
+         n *= 10) {
+        std::string s = gen.lower_string(n);
+        TypeParam your_sa;
+        std::vector<int> sa;
+        auto fp = footprint::measure(your_sa, [&] { sa = your_sa.sa(s); });
+        footprint::record("n_" + std::to_string(n), fp, n);
+        ASSERT_EQ(size_t(n) + 1, sa.size());
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(SuffixArrayMemoryTest, FootprintTest);
 
 }  // namespace algotest
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 // "正しい"LCA
@@ -14,62 +15,79 @@ using V = std::vector<T>;
 template <class T>
 using VV = V<V<T>>;
 
+/**
+ * 行きがけ順 + Sparse Table, クエリO(1)
+ * 行きがけ順で in[u] < in[v] のとき, 行きがけ順 (in[u], in[v]] の頂点の親のうち
+ * 行きがけ順が最小のものが LCA(u, v)
+ */
 struct LCA {
-    int lg;
-    VV<int> anc;
-    V<int> dps;
+    int n = 0;
+    /// in[v]: 頂点 v の行きがけ順, ord[i]: 行きがけ順が i の頂点
+    V<int> in, ord;
+    /// table[k * n + i] = min(p[i], ..., p[i + 2^k - 1]),
+    /// p[i] = in[(ord[i] の親)]
+    V<int> table;
 
     /// lとrの頂点のLCAを求める
-    int query(int l, int r) {
-        if (dps[l] < dps[r])
-            std::swap(l, r);
-        int dd = dps[l] - dps[r];
-        for (int i = lg - 1; i >= 0; i--) {
-            if (dd < (1 << i))
-                continue;
-            dd -= 1 << i;
-            l = anc[i][l];
-        }
+    int query(int l, int r) const {
         if (l == r)
             return l;
-        for (int i = lg - 1; i >= 0; i--) {
-            if (anc[i][l] == anc[i][r])
-                continue;
-            l = anc[i][l];
-            r = anc[i][r];
-        }
-        return anc[0][l];
+        int a = in[l], b = in[r];
+        if (a > b)
+            std::swap(a, b);
+        // 行きがけ順 [a + 1, b + 1) の最小
+        a++;
+        b++;
+        int k = 31 - __builtin_clz(b - a);
+        const int* row = table.data() + size_t(k) * n;
+        return ord[std::min(row[a], row[b - (1 << k)])];
     }
 };
 
 template <class E>
 struct LCA_EXEC : LCA {
-    const VV<E>& g;
-
-    /// 事前処理を行う rはroot頂点のid
-    LCA_EXEC(const VV<E>& _g, int r) : g(_g) {
+    /// 事前処理を行う rはroot頂点のid, 再帰しないので深い木でもよい
+    LCA_EXEC(const VV<E>& g, int r) {
         int N = int(g.size());
-        lg = 1;
-        while ((1 << lg) < N)
-            lg++;
-        anc = VV<int>(lg, V<int>(N, -1));
-        dps = V<int>(N);
-        dfs(r, -1, 0);
-        for (int i = 1; i < lg; i++) {
-            for (int j = 0; j < N; j++) {
-                anc[i][j] =
-                    (anc[i - 1][j] == -1) ? -1 : anc[i - 1][anc[i - 1][j]];
+        n = N;
+        in = V<int>(N, -1);
+        ord.reserve(N);
+        V<int> par(N, -1);
+        // (頂点, 次に見る辺の番号)
+        V<std::pair<int, int>> st;
+        in[r] = 0;
+        ord.push_back(r);
+        st.emplace_back(r, 0);
+        while (!st.empty()) {
+            int v = st.back().first;
+            int& i = st.back().second;
+            if (i == int(g[v].size())) {
+                st.pop_back();
+                continue;
             }
+            int u = g[v][i++].to;
+            if (u == par[v])
+                continue;
+            par[u] = v;
+            in[u] = int(ord.size());
+            ord.push_back(u);
+            st.emplace_back(u, 0);
         }
-    }
 
-    void dfs(int p, int b, int now) {
-        anc[0][p] = b;
-        dps[p] = now;
-        for (E e : g[p]) {
-            if (e.to == b)
-                continue;
-            dfs(e.to, p, now + 1);
+        int m = int(ord.size());
+        int lg = 1;
+        while ((1 << lg) < m)
+            lg++;
+        table = V<int>(size_t(lg) * N);
+        for (int i = 1; i < m; i++) {
+            table[i] = in[par[ord[i]]];
+        }
+        for (int k = 1; k < lg; k++) {
+            int* prv = table.data() + size_t(k - 1) * N;
+            int* cur = table.data() + size_t(k) * N;
+            for (int i = 0; i + (1 << k) <= m; i++) {
+                cur[i] = std::min(prv[i], prv[i + (1 << (k - 1))]);
+            }
         }
     }
 };
@@ -81,4 +99,4 @@ LCA get_lca(const VV<E>& g, int r) {
 
 }  // namespace lca
 
-}  // namespace algotest
\ No newline at end of file
+}  // namespace algotest
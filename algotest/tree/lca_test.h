@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include "../span.h"
 
 namespace algotest {
 
@@ -16,8 +17,25 @@ class LCATesterBase {
     virtual int query(int u, int v) = 0;
 };
 
+/// query をまとめて投げる版
+class LCABatchTesterBase {
+    /// 最初に一度呼ばれる。rは木の根 (0 <= r < g.size())
+    virtual void setup(std::vector<std::vector<LCAEdge>> g, int r) = 0;
+
+    /// u, vのLCAの頂点番号を返す, (0 <= u, v < g.size(), u != v)
+    virtual int query(int u, int v) = 0;
+
+    /// out[i] = query(u[i], v[i]), 各 Span の長さは等しい
+    virtual void query_batch(Span<const int> u,
+                             Span<const int> v,
+                             Span<int> out) = 0;
+};
+
 }  // namespace algotest
 
+#include "../alloc.h"
+#include "../complexity.h"
+#include "../graph/generator.h"
 #include "../random.h"
 #include "gtest/gtest.h"
 #include "lca.h"
@@ -75,7 +93,166 @@ TYPED_TEST_P(LCATest, DirectedTest) {
     ASSERT_EQ(your_lca.query(3, 3), 3);
 }
 
+/// 10^6 頂点の木 (一様ランダム, パス, 細長い木, 毛虫, 星) に 10^6 個のクエリ
+TYPED_TEST_P(LCATest, LargeStressTest) {
+    using G = std::vector<std::vector<LCAEdge>>;
+    const int n = 1000000, q = 1000000;
+    auto gen = algotest::random::Random();
+    std::vector<csr::CSR> trees;
+    trees.push_back(generator::random_tree(n, gen));
+    trees.push_back(generator::path_like_tree(n, 1, gen));
+    trees.push_back(generator::path_like_tree(n, 3, gen));
+    trees.push_back(generator::caterpillar_tree(n, n / 2, gen));
+    trees.push_back(generator::star_tree(n, gen));
+
+    for (auto& tree : trees) {
+        G g = csr::to_adjacency<LCAEdge>(tree);
+        int r = gen.uniform(0, n - 1);
+        TypeParam your_lca;
+        your_lca.setup(g, r);
+        auto my_lca = algotest::lca::get_lca(g, r);
+
+        for (int i = 0; i < q; i++) {
+            int u = gen.uniform(0, n - 1);
+            int v = gen.uniform(0, n - 1);
+            ASSERT_EQ(my_lca.query(u, v), your_lca.query(u, v))
+                << "u = " << u << ", v = " << v;
+        }
+    }
+}
+
 // おまじない
-REGISTER_TYPED_TEST_CASE_P(LCATest, StressTest, DirectedTest);
+REGISTER_TYPED_TEST_CASE_P(LCATest, StressTest, DirectedTest, LargeStressTest);
+
+template <typename LCA>
+class LCAComplexityTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(LCAComplexityTest);
+
+/// n = 2^10 ~ 2^20 で setup と n 回の query の時間を測り,
+/// O(n log n) から外れていないか見る
+TYPED_TEST_P(LCAComplexityTest, SetupQueryTest) {
+    using G = std::vector<std::vector<LCAEdge>>;
+    auto gen = algotest::random::Random();
+    std::vector<complexity::Sample> samples;
+
+    for (int lg = 10; lg <= 20; lg += 2) {
+        int n = 1 << lg;
+        G g(n);
+        for (int i = 1; i < n; i++) {
+            int p = gen.uniform(0, i - 1);
+            g[i].push_back(LCAEdge{p});
+            g[p].push_back(LCAEdge{i});
+        }
+        std::vector<std::pair<int, int>> qs(n);
+        for (auto& q : qs) {
+            q = {gen.uniform(0, n - 1), gen.uniform(0, n - 1)};
+        }
+        double sec = complexity::measure([&] {
+            TypeParam your_lca;
+            your_lca.setup(g, 0);
+            long long sum = 0;
+            for (auto q : qs) {
+                sum += your_lca.query(q.first, q.second);
+            }
+            complexity::keep(sum);
+        });
+        samples.push_back(complexity::Sample{double(n), sec});
+    }
+    double excess = complexity::excess_exponent(samples, complexity::n_log_n);
+    ASSERT_LE(excess, complexity::kMaxExcess) << complexity::dump(samples);
+}
+
+REGISTER_TYPED_TEST_CASE_P(LCAComplexityTest, SetupQueryTest);
+
+template <typename LCA>
+class LCAAllocTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(LCAAllocTest);
+
+/// query はメモリを確保しない (ALGOTEST_ALLOC_HOOKS() がなければ何もしない)
+TYPED_TEST_P(LCAAllocTest, QueryTest) {
+    if (!alloc::installed())
+        return;
+    auto gen = algotest::random::Random();
+    int n = 100000;
+    TypeParam your_lca;
+    your_lca.setup(
+        csr::to_adjacency<LCAEdge>(generator::random_tree(n, gen)), 0);
+    std::vector<std::pair<int, int>> qs;
+    while (int(qs.size()) < n) {
+        int u = gen.uniform(0, n - 1);
+        int v = gen.uniform(0, n - 1);
+        if (u != v)
+            qs.emplace_back(u, v);
+    }
+    long long sum = 0;
+    alloc::Stats st = alloc::measure([&] {
+        for (auto q : qs) {
+            sum += your_lca.query(q.first, q.second);
+        }
+    });
+    ASSERT_EQ(0u, st.count) << alloc::dump(st) << " (sum = " << sum << ")";
+}
+
+REGISTER_TYPED_TEST_CASE_P(LCAAllocTest, QueryTest);
+
+template <typename LCA>
+class LCABatchTest : public ::testing::Test {};
+
+TYPED_TEST_CASE_P(LCABatchTest);
+
+/// query_batch を正しい LCA と比べる
+TYPED_TEST_P(LCABatchTest, StressTest) {
+    auto gen = algotest::random::Random();
+    for (int ph = 0; ph < 100; ph++) {
+        int n = gen.uniform(2, 100);
+        auto g = csr::to_adjacency<LCAEdge>(generator::random_tree(n, gen));
+        int r = gen.uniform(0, n - 1);
+        TypeParam your_lca;
+        your_lca.setup(g, r);
+        auto my_lca = algotest::lca::get_lca(g, r);
+        int q = gen.uniform(0, 100);
+        std::vector<int> us(q), vs(q), out(q, -1);
+        for (int i = 0; i < q; i++) {
+            us[i] = gen.uniform(0, n - 1);
+            vs[i] = gen.uniform(0, n - 2);
+            if (vs[i] >= us[i])
+                vs[i]++;
+        }
+        your_lca.query_batch(us, vs, out);
+        for (int i = 0; i < q; i++) {
+            ASSERT_EQ(my_lca.query(us[i], vs[i]), out[i])
+                << "u = " << us[i] << ", v = " << vs[i];
+        }
+    }
+}
+
+/// 10^6 頂点の木 (一様ランダム, パス) に 10^6 クエリのバッチを投げて query と比べる
+TYPED_TEST_P(LCABatchTest, LargeTest) {
+    const int n = 1000000, q = 1000000;
+    auto gen = algotest::random::Random();
+    std::vector<csr::CSR> trees;
+    trees.push_back(generator::random_tree(n, gen));
+    trees.push_back(generator::path_like_tree(n, 1, gen));
+    for (auto& tree : trees) {
+        TypeParam your_lca;
+        your_lca.setup(csr::to_adjacency<LCAEdge>(tree), gen.uniform(0, n - 1));
+        std::vector<int> us(q), vs(q), out(q, -1);
+        for (int i = 0; i < q; i++) {
+            us[i] = gen.uniform(0, n - 1);
+            vs[i] = gen.uniform(0, n - 2);
+            if (vs[i] >= us[i])
+                vs[i]++;
+        }
+        your_lca.query_batch(us, vs, out);
+        for (int i = 0; i < q; i++) {
+            ASSERT_EQ(your_lca.query(us[i], vs[i]), out[i])
+                << "u = " << us[i] << ", v = " << vs[i];
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(LCABatchTest, StressTest, LargeTest);
 
 }  // namespace algotest